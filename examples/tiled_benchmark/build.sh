@@ -0,0 +1,2 @@
+mkdir -p ../../dist
+g++ -O2 -o ../../dist/goblin3d_tiled_benchmark -I../../src ../../src/goblin3d.cpp tiled_benchmark.c -lm -lpthread
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the Goblin3D.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <goblin3d.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define WIDTH       1920    // Framebuffer width
+#define HEIGHT      1080    // Framebuffer height
+#define SEGMENTS    512     // Sphere segments around and from pole to pole
+#define FRAMES      20      // Frames rendered per thread count
+
+goblin3d_obj_t sphere;          // Dense wireframe sphere used as workload
+goblin3d_framebuffer_t fb;      // Shared RGB565 framebuffer
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Builds a latitude/longitude sphere directly into
+ * the object's arrays, one ring edge and one meridian
+ * edge per vertex.
+ */
+static bool build_sphere() {
+    uint32_t point_count = SEGMENTS * SEGMENTS;
+    if(!goblin3d_init(&sphere, point_count, point_count * 2))
+        return false;
+
+    for(uint32_t lat = 0; lat < SEGMENTS; lat++)
+        for(uint32_t lon = 0; lon < SEGMENTS; lon++) {
+            float theta = M_PI * (lat + 0.5) / SEGMENTS;
+            float phi = 2.0 * M_PI * lon / SEGMENTS;
+            uint32_t i = lat * SEGMENTS + lon;
+
+            sphere.orig_points[i][0] = sin(theta) * cos(phi);
+            sphere.orig_points[i][1] = cos(theta);
+            sphere.orig_points[i][2] = sin(theta) * sin(phi);
+
+            sphere.edges[i * 2][0] = i;
+            sphere.edges[i * 2][1] = lat * SEGMENTS + (lon + 1) % SEGMENTS;
+
+            sphere.edges[i * 2 + 1][0] = i;
+            sphere.edges[i * 2 + 1][1] = ((lat + 1) % SEGMENTS) * SEGMENTS + lon;
+        }
+
+    sphere.scale_size = 1500.0;
+    sphere.x_offset = WIDTH / 2;
+    sphere.y_offset = HEIGHT / 2;
+
+    return true;
+}
+
+int main(void) {
+    if(!build_sphere() || !goblin3d_framebuffer_init(&fb, WIDTH, HEIGHT, false)) {
+        printf("Failed to initialize benchmark.\n");
+        return 1;
+    }
+
+    long max_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if(max_threads < 1)
+        max_threads = 1;
+    else if(max_threads > 64)
+        max_threads = 64;
+
+    printf("%u edges, %dx%d framebuffer, %d frames per run\n\n",
+        sphere.edge_count, WIDTH, HEIGHT, FRAMES);
+    printf("threads    ms/frame    Medges/s    speedup\n");
+
+    double baseline = 0.0;
+    for(long threads = 1; threads <= max_threads; threads *= 2) {
+        goblin3d_tiler_t tiler;
+        if(!goblin3d_tiler_init(&tiler, WIDTH, HEIGHT, threads)) {
+            printf("Failed to initialize tiled renderer.\n");
+            return 1;
+        }
+
+        double elapsed = 0.0;
+        for(int frame = 0; frame < FRAMES; frame++) {
+            sphere.x_angle_deg = frame * 3.0;
+            sphere.y_angle_deg = frame * 2.0;
+            goblin3d_precalculate(&sphere);
+            goblin3d_framebuffer_clear(&fb, 0x0000);
+
+            double start = now();
+            goblin3d_render_tiled(&sphere, &tiler, &fb, 0xFFFF);
+            elapsed += now() - start;
+        }
+
+        double per_frame = elapsed / FRAMES;
+        if(threads == 1)
+            baseline = per_frame;
+
+        printf("%7ld %11.2f %11.2f %9.2fx\n", threads, per_frame * 1e3,
+            sphere.edge_count / per_frame / 1e6, baseline / per_frame);
+        goblin3d_tiler_free(&tiler);
+
+        if(threads < max_threads && threads * 2 > max_threads)
+            threads = max_threads / 2;
+    }
+
+    goblin3d_framebuffer_free(&fb);
+    goblin3d_free(&sphere);
+
+    return 0;
+}
@@ -31,67 +31,109 @@
 #   include <stdio.h>
 #   include <stdlib.h>
 #   include <string.h>
+#   include <time.h>
+#endif
+
+#ifdef GOBLIN3D_POSIX
+#   include <fcntl.h>
+#   include <pthread.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#define GOBLIN3D_EDGE_HAS_FACE  0x01
+#define GOBLIN3D_EDGE_FRONT     0x02
+
+#define GOBLIN3D_BORROWED_POINTS        0x01
+#define GOBLIN3D_BORROWED_EDGES         0x02
+#define GOBLIN3D_BORROWED_FACES         0x04
+#define GOBLIN3D_BORROWED_FACE_EDGES    0x08
+#define GOBLIN3D_BORROWED_STRIPS        0x10
+
+#define GOBLIN3D_POINT_SHADES           16
+
+#define GOBLIN3D_STL_EDGE_BORDER        0x01
+#define GOBLIN3D_STL_EDGE_SMOOTH        0x02
+#define GOBLIN3D_STL_EDGE_FEATURE       0x03
+
+#define GOBLIN3D_PLY_MAX_ELEMENTS       8
+#define GOBLIN3D_PLY_MAX_PROPERTIES     24
+
+#define GOBLIN3D_PLY_OTHER              0x00
+#define GOBLIN3D_PLY_VERTEX             0x01
+#define GOBLIN3D_PLY_FACE               0x02
+
+#define GOBLIN3D_PLY_ROLE_X             0x01
+#define GOBLIN3D_PLY_ROLE_Y             0x02
+#define GOBLIN3D_PLY_ROLE_Z             0x03
+#define GOBLIN3D_PLY_ROLE_INDICES       0x04
+
+#define GOBLIN3D_PLY_FLOAT32            7
+#define GOBLIN3D_PLY_FLOAT64            8
+
+#ifdef GOBLIN3D_POSIX
+
+static bool goblin3d_map_file(const char* filename, const char** data, size_t* length) {
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(mapping == MAP_FAILED)
+        return false;
+    madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+
+    *data = (const char*) mapping;
+    *length = info.st_size;
+
+    return true;
+}
+
+static void goblin3d_unmap_file(const char* data, size_t length) {
+    munmap((void*) data, length);
+}
+
 #endif
 
 bool goblin3d_init(goblin3d_obj_t* obj, uint32_t point_count, uint32_t edge_count) {
-    size_t fsize = sizeof(float);
-    size_t fpsize = sizeof(float*);
+    goblin3d_init_empty(obj);
 
     obj->point_count = point_count;
     obj->edge_count = edge_count;
 
-    obj->points = (float**) malloc(fpsize * point_count);
+    obj->points = (float(*)[2]) malloc(sizeof(float[2]) * point_count);
     if(!obj->points) {
         goblin3d_free(obj);
         return false;
     }
 
-    obj->edges = (uint32_t**) malloc(sizeof(uint32_t**) * edge_count);
+    obj->edges = (uint32_t(*)[2]) malloc(sizeof(uint32_t[2]) * edge_count);
     if(!obj->edges) {
         goblin3d_free(obj);
         return false;
     }
 
-    obj->orig_points = (float**) malloc(fpsize * point_count);
+    obj->orig_points = (float(*)[3]) malloc(sizeof(float[3]) * point_count);
     if(!obj->orig_points) {
         goblin3d_free(obj);
         return false;
     }
 
-    obj->rotated_points = (float**) malloc(fpsize * point_count);
+    obj->rotated_points = (float(*)[3]) malloc(sizeof(float[3]) * point_count);
     if(!obj->rotated_points) {
         goblin3d_free(obj);
         return false;
     }
 
-    for(uint32_t i = 0; i < point_count; i++) {
-        obj->points[i] = (float*) malloc(fsize * 2);
-        if(!obj->points[i]) {
-            goblin3d_free(obj);
-            return false;
-        }
-
-        obj->orig_points[i] = (float*) malloc(fsize * 3);
-        if(!obj->orig_points[i]) {
-            goblin3d_free(obj);
-            return false;
-        }
-
-        obj->rotated_points[i] = (float*) malloc(fsize * 3);
-        if(!obj->rotated_points[i]) {
-            goblin3d_free(obj);
-            return false;
-        }
-    }
-
-    for(uint32_t i = 0; i < edge_count; i++) {
-        obj->edges[i] = (uint32_t*) malloc(sizeof(uint32_t) * 2);
-        if(!obj->edges[i]) {
-            goblin3d_free(obj);
-            return false;
-        }
-    }
-
     obj->x_angle_deg = 0.0;
     obj->y_angle_deg = 0.0;
     obj->z_angle_deg = 0.0;
@@ -106,265 +148,5961 @@ bool goblin3d_init(goblin3d_obj_t* obj, uint32_t point_count, uint32_t edge_coun
 void goblin3d_init_empty(goblin3d_obj_t* obj) {
     obj->point_count = 0;
     obj->edge_count = 0;
+    obj->face_count = 0;
+    obj->dropped_count = 0;
 
     obj->points = NULL;
     obj->orig_points = NULL;
     obj->rotated_points = NULL;
     obj->edges = NULL;
+    obj->faces = NULL;
+    obj->face_edges = NULL;
+    obj->edge_flags = NULL;
+    obj->face_order = NULL;
+    obj->strip_indices = NULL;
+    obj->strip_offsets = NULL;
+    obj->strip_count = 0;
+    obj->render_flags = 0;
+
+    obj->lods = NULL;
+    obj->lod_count = 0;
+    obj->lod_level = 0;
+    obj->edge_table = NULL;
+    obj->edge_table_bits = 0;
+
+    obj->bound_center[0] = 0.0;
+    obj->bound_center[1] = 0.0;
+    obj->bound_center[2] = 0.0;
+    obj->bound_radius = 0.0;
+    obj->bounds_valid = false;
+
+    for(uint8_t i = 0; i < 3; i++) {
+        obj->bound_min[i] = 0.0;
+        obj->bound_max[i] = 0.0;
+    }
+
+    obj->viewport_width = 0;
+    obj->viewport_height = 0;
+    obj->culled = false;
+
+    obj->borrowed = 0;
+    obj->mapping = NULL;
+    obj->mapping_size = 0;
 }
 
-void goblin3d_free(goblin3d_obj_t* obj) {
-    for(uint32_t i = 0; i < obj->point_count; i++) {
-        if(obj->points[i])
-            free(obj->points[i]);
+bool goblin3d_init_from_arrays(goblin3d_obj_t* obj, const float (*points)[3], uint32_t point_count,
+    const uint32_t (*edges)[2], uint32_t edge_count) {
+    goblin3d_init_empty(obj);
+
+    obj->point_count = point_count;
+    obj->edge_count = edge_count;
 
-        if(obj->orig_points[i])
-            free(obj->orig_points[i]);
+    obj->orig_points = (float(*)[3]) points;
+    obj->edges = (uint32_t(*)[2]) edges;
+    obj->borrowed = GOBLIN3D_BORROWED_POINTS | GOBLIN3D_BORROWED_EDGES;
 
-        if(obj->rotated_points[i])
-            free(obj->rotated_points[i]);
+    obj->points = (float(*)[2]) malloc(sizeof(float[2]) * (point_count + 1));
+    obj->rotated_points = (float(*)[3]) malloc(sizeof(float[3]) * (point_count + 1));
+
+    if(!obj->points || !obj->rotated_points) {
+        goblin3d_free(obj);
+        goblin3d_init_empty(obj);
+        return false;
     }
 
-    for(uint32_t i = 0; i < obj->edge_count; i++)
-        if(obj->edges[i])
-            free(obj->edges[i]);
+    return true;
+}
+
+static void goblin3d_free_lods(goblin3d_obj_t* obj) {
+    for(uint8_t i = 0; i < obj->lod_count; i++) {
+        free(obj->lods[i].edges);
+        free(obj->lods[i].point_indices);
+    }
 
+    if(obj->lods)
+        free(obj->lods);
+
+    obj->lods = NULL;
+    obj->lod_count = 0;
+    obj->lod_level = 0;
+}
+
+static void goblin3d_free_strips(goblin3d_obj_t* obj) {
+    if(obj->strip_indices)
+        free(obj->strip_indices);
+
+    if(obj->strip_offsets)
+        free(obj->strip_offsets);
+
+    obj->strip_indices = NULL;
+    obj->strip_offsets = NULL;
+    obj->strip_count = 0;
+}
+
+static void goblin3d_free_edge_table(goblin3d_obj_t* obj) {
+    if(obj->edge_table)
+        free(obj->edge_table);
+
+    obj->edge_table = NULL;
+    obj->edge_table_bits = 0;
+}
+
+void goblin3d_free(goblin3d_obj_t* obj) {
     if(obj->points)
         free(obj->points);
 
-    if(obj->edges)
+    if(obj->edges && !(obj->borrowed & GOBLIN3D_BORROWED_EDGES))
         free(obj->edges);
 
-    if(obj->orig_points)
+    if(obj->orig_points && !(obj->borrowed & GOBLIN3D_BORROWED_POINTS))
         free(obj->orig_points);
 
     if(obj->rotated_points)
         free(obj->rotated_points);
-}
 
-void goblin3d_precalculate(goblin3d_obj_t* obj) {
-    float radX = obj->x_angle_deg * 0.01745329251;
-    float radY = obj->y_angle_deg * 0.01745329251;
-    float radZ = obj->z_angle_deg * 0.01745329251;
+    if(obj->faces && !(obj->borrowed & GOBLIN3D_BORROWED_FACES))
+        free(obj->faces);
 
-    float cosX = cos(radX);
-    float cosY = cos(radY);
-    float cosZ = cos(radZ);
+    if(obj->face_edges && !(obj->borrowed & GOBLIN3D_BORROWED_FACE_EDGES))
+        free(obj->face_edges);
 
-    float sinX = sin(radX);
-    float sinY = sin(radY);
-    float sinZ = sin(radZ);
+    if(obj->edge_flags)
+        free(obj->edge_flags);
 
-    for(uint32_t i = 0; i < obj->point_count; i++) {
-        float x = obj->orig_points[i][0];
-        float y = obj->orig_points[i][1];
-        float z = obj->orig_points[i][2];
+    if(obj->face_order)
+        free(obj->face_order);
 
-        float temp_y = y * cosX - z * sinX;
-        z = y * sinX + z * cosX;
-        y = temp_y;
+    if(!(obj->borrowed & GOBLIN3D_BORROWED_STRIPS)) {
+        if(obj->strip_indices)
+            free(obj->strip_indices);
 
-        float temp_x = x * cosY + z * sinY;
-        z = -x * sinY + z * cosY;
-        x = temp_x;
+        if(obj->strip_offsets)
+            free(obj->strip_offsets);
+    }
 
-        temp_x = x * cosZ - y * sinZ;
-        y = x * sinZ + y * cosZ;
-        x = temp_x;
+    goblin3d_free_lods(obj);
+    goblin3d_free_edge_table(obj);
 
-        obj->rotated_points[i][0] = x;
-        obj->rotated_points[i][1] = y;
-        obj->rotated_points[i][2] = z + obj->z_offset;
+    #ifdef GOBLIN3D_POSIX
+    if(obj->mapping)
+        goblin3d_unmap_file((const char*) obj->mapping, obj->mapping_size);
+    #endif
 
-        float z_clamped = z < -3.0 ? z : -3.0;
-        obj->points[i][0] = round(obj->rotated_points[i][0] / z_clamped * obj->scale_size) + obj->x_offset;
-        obj->points[i][1] = round(obj->rotated_points[i][1] / z_clamped * obj->scale_size) + obj->y_offset;
-    }
+    obj->borrowed = 0;
+    obj->mapping = NULL;
 }
 
-void goblin3d_render(goblin3d_obj_t* obj, goblin3d_obj_draw_fn draw) {
-    uint32_t i = 0;
+static bool goblin3d_own_array(void** array, size_t size) {
+    void* copy = malloc(size > 0 ? size : 1);
+    if(!copy)
+        return false;
 
-    while(i < obj->edge_count) {
-        uint32_t start = obj->edges[i][0], end = obj->edges[i++][1];
-        draw(
-            obj->points[start][0],
-            obj->points[start][1],
-            obj->points[end][0],
-            obj->points[end][1]
-        );
-    }
-}
+    if(*array)
+        memcpy(copy, *array, size);
+    *array = copy;
 
-bool goblin3d_add_point(goblin3d_obj_t* obj, float x, float y, float z) {
-    obj->point_count++;
+    return true;
+}
 
-    obj->orig_points = (float**) realloc(obj->orig_points, obj->point_count * sizeof(float*));
-    if(obj->orig_points == NULL)
+static bool goblin3d_own(goblin3d_obj_t* obj) {
+    if((obj->borrowed & GOBLIN3D_BORROWED_POINTS) &&
+        !goblin3d_own_array((void**) &obj->orig_points, sizeof(float[3]) * obj->point_count))
         return false;
+    obj->borrowed &= ~GOBLIN3D_BORROWED_POINTS;
 
-    obj->rotated_points = (float**) realloc(obj->rotated_points, obj->point_count * sizeof(float*));
-    if(obj->rotated_points == NULL)
+    if((obj->borrowed & GOBLIN3D_BORROWED_EDGES) &&
+        !goblin3d_own_array((void**) &obj->edges, sizeof(uint32_t[2]) * obj->edge_count))
         return false;
+    obj->borrowed &= ~GOBLIN3D_BORROWED_EDGES;
 
-    obj->points = (float**) realloc(obj->points, obj->point_count * sizeof(float*));
-    if(obj->points == NULL)
+    if((obj->borrowed & GOBLIN3D_BORROWED_FACES) &&
+        !goblin3d_own_array((void**) &obj->faces, sizeof(uint32_t[3]) * obj->face_count))
         return false;
+    obj->borrowed &= ~GOBLIN3D_BORROWED_FACES;
 
-    obj->orig_points[obj->point_count - 1] = (float*) malloc(3 * sizeof(float));
-    if(obj->orig_points == NULL)
+    if((obj->borrowed & GOBLIN3D_BORROWED_FACE_EDGES) &&
+        !goblin3d_own_array((void**) &obj->face_edges, sizeof(uint32_t[3]) * obj->face_count))
         return false;
+    obj->borrowed &= ~GOBLIN3D_BORROWED_FACE_EDGES;
 
-    obj->rotated_points[obj->point_count - 1] = (float*) malloc(3 * sizeof(float));
-    if(obj->rotated_points == NULL)
-        return false;
+    if(obj->borrowed & GOBLIN3D_BORROWED_STRIPS) {
+        uint32_t index_count = obj->strip_count > 0 ? obj->strip_offsets[obj->strip_count] : 0;
 
-    obj->points[obj->point_count - 1] = (float*) malloc(3 * sizeof(float));
-    if(obj->points == NULL)
-        return false;
+        uint32_t* strip_indices = obj->strip_indices;
+        uint32_t* strip_offsets = obj->strip_offsets;
 
-    obj->orig_points[obj->point_count - 1][0] = x;
-    obj->orig_points[obj->point_count - 1][1] = y;
-    obj->orig_points[obj->point_count - 1][2] = z;
+        if(!goblin3d_own_array((void**) &strip_indices, sizeof(uint32_t) * index_count))
+            return false;
+
+        if(!goblin3d_own_array((void**) &strip_offsets, sizeof(uint32_t) * (obj->strip_count + 1))) {
+            free(strip_indices);
+            return false;
+        }
+
+        obj->strip_indices = strip_indices;
+        obj->strip_offsets = strip_offsets;
+    }
+    obj->borrowed = 0;
+
+    #ifdef GOBLIN3D_POSIX
+    if(obj->mapping)
+        goblin3d_unmap_file((const char*) obj->mapping, obj->mapping_size);
+    #endif
+    obj->mapping = NULL;
 
     return true;
 }
 
-bool goblin3d_edge_exists(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2) {
-    for(int i = 0; i < obj->edge_count; ++i) {
-        uint32_t existing_v1 = obj->edges[i][0],
-            existing_v2 = obj->edges[i][1];
-        if((existing_v1 == v1 && existing_v2 == v2) ||
-            (existing_v1 == v2 && existing_v2 == v1))
-            return true;
-    }
+typedef struct {
+    float cos_x, sin_x;
+    float cos_y, sin_y;
+    float cos_z, sin_z;
+} goblin3d_rotation_t;
 
-    return false;
+static void goblin3d_rotation_angles(float x_angle_deg, float y_angle_deg, float z_angle_deg,
+    goblin3d_rotation_t* rotation) {
+    float radX = x_angle_deg * 0.01745329251;
+    float radY = y_angle_deg * 0.01745329251;
+    float radZ = z_angle_deg * 0.01745329251;
+
+    rotation->cos_x = cos(radX);
+    rotation->cos_y = cos(radY);
+    rotation->cos_z = cos(radZ);
+
+    rotation->sin_x = sin(radX);
+    rotation->sin_y = sin(radY);
+    rotation->sin_z = sin(radZ);
 }
 
-bool goblin3d_add_edge(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2) {
-    if(goblin3d_edge_exists(obj, v1, v2))
-        return true;
+static void goblin3d_rotation(goblin3d_obj_t* obj, goblin3d_rotation_t* rotation) {
+    goblin3d_rotation_angles(obj->x_angle_deg, obj->y_angle_deg, obj->z_angle_deg, rotation);
+}
 
-    obj->edge_count++;
-    obj->edges = (uint32_t**) realloc(obj->edges, obj->edge_count * sizeof(uint32_t*));
-    if(obj->edges == NULL)
-        return false;
+static inline void goblin3d_rotate(const goblin3d_rotation_t* rotation, float* x, float* y, float* z) {
+    float temp_y = *y * rotation->cos_x - *z * rotation->sin_x;
+    *z = *y * rotation->sin_x + *z * rotation->cos_x;
+    *y = temp_y;
 
-    obj->edges[obj->edge_count - 1] = (uint32_t*)malloc(2 * sizeof(uint32_t));
-    obj->edges[obj->edge_count - 1][0] = v1;
-    obj->edges[obj->edge_count - 1][1] = v2;
+    float temp_x = *x * rotation->cos_y + *z * rotation->sin_y;
+    *z = -*x * rotation->sin_y + *z * rotation->cos_y;
+    *x = temp_x;
 
-    return true;
+    temp_x = *x * rotation->cos_z - *y * rotation->sin_z;
+    *y = *x * rotation->sin_z + *y * rotation->cos_z;
+    *x = temp_x;
 }
 
-bool goblin3d_parse_obj_file(const char* filename, goblin3d_obj_t* obj) {
-    #ifdef ARDUINO
-    File file = SD.open(filename);
-    if(!file)
-        return false;
-    goblin3d_init_empty(obj);
+static inline void goblin3d_project_point(const goblin3d_obj_t* obj, const goblin3d_rotation_t* rotation, uint32_t i,
+    float rotated[3], float projected[2]) {
+    float x = obj->orig_points[i][0];
+    float y = obj->orig_points[i][1];
+    float z = obj->orig_points[i][2];
 
-    String line = "";
-    while(file.available()) {
-        char c = file.read();
+    goblin3d_rotate(rotation, &x, &y, &z);
 
-        if(c == '\n' || c == '\r') {
-            if(line.startsWith("v ")) {
-                float x, y, z;
+    rotated[0] = x;
+    rotated[1] = y;
+    rotated[2] = z + obj->z_offset;
 
-                sscanf(line.c_str() + 2, "%f %f %f", &x, &y, &z);
-                if (!goblin3d_add_point(obj, x, y, z)) {
-                    file.close();
-                    return false;
-                }
-            }
-            else if(line.startsWith("f ")) {
-                uint32_t vertex_indices[4];
-                int count = sscanf(
-                    line.c_str() + 2, 
-                    "%u %u %u %u", 
-                    &vertex_indices[0], 
-                    &vertex_indices[1], 
-                    &vertex_indices[2], 
-                    &vertex_indices[3]
-                );
-
-                if(count == 3) {
-                    goblin3d_add_edge(obj, vertex_indices[0] - 1, vertex_indices[1] - 1);
-                    goblin3d_add_edge(obj, vertex_indices[1] - 1, vertex_indices[2] - 1);
-                    goblin3d_add_edge(obj, vertex_indices[2] - 1, vertex_indices[0] - 1);
-                }
-                else if(count == 4) {
-                    goblin3d_add_edge(obj, vertex_indices[0] - 1, vertex_indices[1] - 1);
-                    goblin3d_add_edge(obj, vertex_indices[1] - 1, vertex_indices[2] - 1);
-                    goblin3d_add_edge(obj, vertex_indices[2] - 1, vertex_indices[3] - 1);
-                    goblin3d_add_edge(obj, vertex_indices[3] - 1, vertex_indices[0] - 1);
-                }
-            }
-            else if(line[0] == 'm' || line[0] == 'o' ||
-                line[0] == '#' || line[0] == 'g' ||
-                line[0] == 's' || line[0] == 'u' ||
-                line[0] == 'n');
+    float z_clamped = z < -3.0 ? z : -3.0;
+    projected[0] = round(x / z_clamped * obj->scale_size) + obj->x_offset;
+    projected[1] = round(y / z_clamped * obj->scale_size) + obj->y_offset;
+}
+
+static inline void goblin3d_transform_point(goblin3d_obj_t* obj, const goblin3d_rotation_t* rotation, uint32_t i) {
+    goblin3d_project_point(obj, rotation, i, obj->rotated_points[i], obj->points[i]);
+}
+
+static void goblin3d_select_lod(goblin3d_obj_t* obj, const goblin3d_rotation_t* rotation) {
+    float x = obj->bound_center[0];
+    float y = obj->bound_center[1];
+    float z = obj->bound_center[2];
+
+    goblin3d_rotate(rotation, &x, &y, &z);
+
+    float z_clamped = z < -3.0 ? z : -3.0;
+    float radius = obj->bound_radius * obj->scale_size / -z_clamped;
+
+    uint8_t level = obj->lod_level;
+    if(level > obj->lod_count)
+        level = obj->lod_count;
+
+    while(level < obj->lod_count &&
+        radius < obj->lods[level].max_radius * (1.0 - GOBLIN3D_LOD_HYSTERESIS))
+        level++;
+
+    while(level > 0 &&
+        radius > obj->lods[level - 1].max_radius * (1.0 + GOBLIN3D_LOD_HYSTERESIS))
+        level--;
+
+    obj->lod_level = level;
+}
+
+void goblin3d_update_bounds(goblin3d_obj_t* obj) {
+    float min[3] = { INFINITY, INFINITY, INFINITY };
+    float max[3] = { -INFINITY, -INFINITY, -INFINITY };
 
-            line = "";
+    for(uint32_t i = 0; i < obj->point_count; i++)
+        for(uint8_t j = 0; j < 3; j++) {
+            if(obj->orig_points[i][j] < min[j]) min[j] = obj->orig_points[i][j];
+            if(obj->orig_points[i][j] > max[j]) max[j] = obj->orig_points[i][j];
         }
-        else line += c;
+
+    float radius_sq = 0.0;
+    for(uint8_t j = 0; j < 3; j++) {
+        obj->bound_min[j] = obj->point_count ? min[j] : 0.0;
+        obj->bound_max[j] = obj->point_count ? max[j] : 0.0;
+        obj->bound_center[j] = (obj->bound_min[j] + obj->bound_max[j]) * 0.5;
     }
 
-    file.close();
-    return true;
+    for(uint32_t i = 0; i < obj->point_count; i++) {
+        float dx = obj->orig_points[i][0] - obj->bound_center[0];
+        float dy = obj->orig_points[i][1] - obj->bound_center[1];
+        float dz = obj->orig_points[i][2] - obj->bound_center[2];
+        float distance_sq = dx * dx + dy * dy + dz * dz;
 
-    #else
+        if(distance_sq > radius_sq)
+            radius_sq = distance_sq;
+    }
 
-    FILE* file = fopen(filename, "r");
-    if(!file)
-        return false;
-    goblin3d_init_empty(obj);
+    obj->bound_radius = sqrtf(radius_sq);
+    obj->bounds_valid = true;
+}
 
-    char line[256];
-    while(fgets(line, sizeof(line), file)) {
-        if(strncmp(line, "v ", 2) == 0) {
-            float x, y, z;
-            sscanf(line + 2, "%f %f %f", &x, &y, &z);
-            
-            if(!goblin3d_add_point(obj, x, y, z))
-                return false;
-        }
-        else if(strncmp(line, "f ", 2) == 0) {
-            uint32_t vertex_indices[4];
-            int count = sscanf(
-                line + 2,
-                "%hhu %hhu %hhu %hhu", 
-                &vertex_indices[0], 
-                &vertex_indices[1], 
-                &vertex_indices[2], 
-                &vertex_indices[3]
-            );
+static bool goblin3d_outside_viewport(goblin3d_obj_t* obj, const goblin3d_rotation_t* rotation) {
+    float center[3] = { obj->bound_center[0], obj->bound_center[1], obj->bound_center[2] };
+    float extent[3] = { 0.0, 0.0, 0.0 };
 
-            if(count == 3) {
-                if(!goblin3d_add_edge(obj, vertex_indices[0] - 1, vertex_indices[1] - 1) ||
-                    !goblin3d_add_edge(obj, vertex_indices[1] - 1, vertex_indices[2] - 1) ||
-                    !goblin3d_add_edge(obj, vertex_indices[2] - 1, vertex_indices[0] - 1))
-                    return false;
-            }
-            else if(count == 4) {
-                if(!goblin3d_add_edge(obj, vertex_indices[0] - 1, vertex_indices[1] - 1) ||
-                    !goblin3d_add_edge(obj, vertex_indices[1] - 1, vertex_indices[2] - 1) ||
-                    !goblin3d_add_edge(obj, vertex_indices[2] - 1, vertex_indices[3] - 1) ||
-                    !goblin3d_add_edge(obj, vertex_indices[3] - 1, vertex_indices[0] - 1))
-                    return false;
+    goblin3d_rotate(rotation, &center[0], &center[1], &center[2]);
+    for(uint8_t i = 0; i < 3; i++) {
+        float axis[3] = { 0.0, 0.0, 0.0 };
+        axis[i] = (obj->bound_max[i] - obj->bound_min[i]) * 0.5;
+
+        goblin3d_rotate(rotation, &axis[0], &axis[1], &axis[2]);
+        for(uint8_t j = 0; j < 3; j++)
+            extent[j] += fabsf(axis[j]);
+    }
+
+    for(uint8_t i = 0; i < 3; i++)
+        if(extent[i] > obj->bound_radius)
+            extent[i] = obj->bound_radius;
+
+    float near_depth = -(center[2] + extent[2]), far_depth = -(center[2] - extent[2]);
+    float depths[2] = {
+        near_depth > 3.0f ? near_depth : 3.0f,
+        far_depth > 3.0f ? far_depth : 3.0f
+    };
+
+    float min[2] = { INFINITY, INFINITY }, max[2] = { -INFINITY, -INFINITY };
+    float offsets[2] = { obj->x_offset, obj->y_offset };
+
+    for(uint8_t axis = 0; axis < 2; axis++)
+        for(uint8_t i = 0; i < 2; i++)
+            for(uint8_t j = 0; j < 2; j++) {
+                float coordinate = center[axis] + (i ? extent[axis] : -extent[axis]);
+                float projected = -coordinate / depths[j] * obj->scale_size + offsets[axis];
+
+                if(projected < min[axis]) min[axis] = projected;
+                if(projected > max[axis]) max[axis] = projected;
             }
-        }
-        else if(line[0] == 'm' || line[0] == 'o' ||
-            line[0] == '#' || line[0] == 'g' ||
-            line[0] == 's' || line[0] == 'u' ||
-            line[0] == 'n')
+
+    return max[0] < -1.0 || min[0] > obj->viewport_width ||
+        max[1] < -1.0 || min[1] > obj->viewport_height;
+}
+
+void goblin3d_precalculate(goblin3d_obj_t* obj) {
+    goblin3d_rotation_t rotation;
+    goblin3d_rotation(obj, &rotation);
+
+    if(obj->viewport_width > 0 && obj->viewport_height > 0) {
+        if(!obj->bounds_valid)
+            goblin3d_update_bounds(obj);
+
+        obj->culled = goblin3d_outside_viewport(obj, &rotation);
+        if(obj->culled)
+            return;
+    }
+    else obj->culled = false;
+
+    bool cull = (obj->render_flags & GOBLIN3D_RENDER_CULL_BACKFACES) &&
+        obj->face_count > 0 && obj->edge_flags;
+
+    if((obj->render_flags & GOBLIN3D_RENDER_LOD) && obj->lod_count > 0 && !cull) {
+        if(!obj->bounds_valid)
+            goblin3d_update_bounds(obj);
+
+        goblin3d_select_lod(obj, &rotation);
+    }
+    else obj->lod_level = 0;
+
+    if(obj->lod_level > 0) {
+        goblin3d_lod_t* lod = &obj->lods[obj->lod_level - 1];
+
+        for(uint32_t i = 0; i < lod->point_count; i++)
+            goblin3d_transform_point(obj, &rotation, lod->point_indices[i]);
+        return;
+    }
+
+    for(uint32_t i = 0; i < obj->point_count; i++)
+        goblin3d_transform_point(obj, &rotation, i);
+}
+
+static void goblin3d_transform_full(goblin3d_obj_t* obj) {
+    if(obj->lod_level == 0)
+        return;
+
+    goblin3d_rotation_t rotation;
+    goblin3d_rotation(obj, &rotation);
+
+    for(uint32_t i = 0; i < obj->point_count; i++)
+        goblin3d_transform_point(obj, &rotation, i);
+}
+
+static void goblin3d_mark_front_edges(goblin3d_obj_t* obj) {
+    for(uint32_t i = 0; i < obj->edge_count; i++)
+        obj->edge_flags[i] &= ~GOBLIN3D_EDGE_FRONT;
+
+    for(uint32_t i = 0; i < obj->face_count; i++) {
+        float* a = obj->points[obj->faces[i][0]];
+        float* b = obj->points[obj->faces[i][1]];
+        float* c = obj->points[obj->faces[i][2]];
+
+        float winding = (b[0] - a[0]) * (c[1] - a[1]) -
+            (b[1] - a[1]) * (c[0] - a[0]);
+        if(winding <= 0.0)
             continue;
+
+        for(uint8_t j = 0; j < 3; j++)
+            if(obj->face_edges[i][j] != GOBLIN3D_NO_EDGE)
+                obj->edge_flags[obj->face_edges[i][j]] |= GOBLIN3D_EDGE_FRONT;
     }
+}
 
-    fclose(file);
-    return true;
+static inline bool goblin3d_edge_culled(goblin3d_obj_t* obj, uint32_t edge) {
+    uint8_t flags = obj->edge_flags[edge];
+    return (flags & GOBLIN3D_EDGE_HAS_FACE) && !(flags & GOBLIN3D_EDGE_FRONT);
+}
 
-    #endif
-}
\ No newline at end of file
+static void goblin3d_render_culled(goblin3d_obj_t* obj, goblin3d_obj_draw_fn draw) {
+    goblin3d_mark_front_edges(obj);
+
+    for(uint32_t i = 0; i < obj->edge_count; i++) {
+        if(goblin3d_edge_culled(obj, i))
+            continue;
+
+        uint32_t start = obj->edges[i][0], end = obj->edges[i][1];
+        draw(
+            obj->points[start][0],
+            obj->points[start][1],
+            obj->points[end][0],
+            obj->points[end][1]
+        );
+    }
+}
+
+void goblin3d_render(goblin3d_obj_t* obj, goblin3d_obj_draw_fn draw) {
+    if(obj->culled)
+        return;
+
+    if(obj->lod_level > 0) {
+        goblin3d_lod_t* lod = &obj->lods[obj->lod_level - 1];
+
+        for(uint32_t i = 0; i < lod->edge_count; i++) {
+            uint32_t start = lod->edges[i][0], end = lod->edges[i][1];
+            draw(
+                obj->points[start][0],
+                obj->points[start][1],
+                obj->points[end][0],
+                obj->points[end][1]
+            );
+        }
+
+        return;
+    }
+
+    if((obj->render_flags & GOBLIN3D_RENDER_CULL_BACKFACES) &&
+        obj->face_count > 0 && obj->edge_flags) {
+        goblin3d_render_culled(obj, draw);
+        return;
+    }
+
+    uint32_t i = 0;
+
+    while(i < obj->edge_count) {
+        uint32_t start = obj->edges[i][0], end = obj->edges[i++][1];
+        draw(
+            obj->points[start][0],
+            obj->points[start][1],
+            obj->points[end][0],
+            obj->points[end][1]
+        );
+    }
+}
+
+void goblin3d_render_strips(goblin3d_obj_t* obj, goblin3d_obj_polyline_fn polyline) {
+    uint16_t xy[GOBLIN3D_STRIP_BATCH * 2];
+    if(obj->culled)
+        return;
+    goblin3d_transform_full(obj);
+
+    if(obj->strip_count == 0) {
+        for(uint32_t i = 0; i < obj->edge_count; i++) {
+            xy[0] = obj->points[obj->edges[i][0]][0];
+            xy[1] = obj->points[obj->edges[i][0]][1];
+            xy[2] = obj->points[obj->edges[i][1]][0];
+            xy[3] = obj->points[obj->edges[i][1]][1];
+
+            polyline(xy, 2);
+        }
+
+        return;
+    }
+
+    for(uint32_t i = 0; i < obj->strip_count; i++) {
+        uint32_t count = 0;
+
+        for(uint32_t j = obj->strip_offsets[i]; j < obj->strip_offsets[i + 1]; j++) {
+            float* point = obj->points[obj->strip_indices[j]];
+
+            xy[count * 2] = point[0];
+            xy[count * 2 + 1] = point[1];
+
+            if(++count == GOBLIN3D_STRIP_BATCH) {
+                polyline(xy, count);
+
+                xy[0] = xy[count * 2 - 2];
+                xy[1] = xy[count * 2 - 1];
+                count = 1;
+            }
+        }
+
+        if(count > 1)
+            polyline(xy, count);
+    }
+}
+
+bool goblin3d_depth_init(goblin3d_depth_t* depth, uint16_t screen_width, uint16_t screen_height, uint8_t shift) {
+    uint16_t cell = 1 << shift;
+
+    depth->shift = shift;
+    depth->bias = 0.02;
+    depth->width = (screen_width + cell - 1) >> shift;
+    depth->height = (screen_height + cell - 1) >> shift;
+
+    depth->depth = (float*) malloc(sizeof(float) * depth->width * depth->height);
+    return depth->depth != NULL;
+}
+
+void goblin3d_depth_free(goblin3d_depth_t* depth) {
+    if(depth->depth)
+        free(depth->depth);
+    depth->depth = NULL;
+}
+
+static void goblin3d_depth_raster(goblin3d_depth_t* depth, const float* a, const float* b, const float* c,
+    float za, float zb, float zc) {
+    float scale = 1.0 / (1 << depth->shift);
+    float ax = a[0] * scale, ay = a[1] * scale;
+    float bx = b[0] * scale, by = b[1] * scale;
+    float cx = c[0] * scale, cy = c[1] * scale;
+
+    float area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    if(area == 0.0)
+        return;
+
+    float min_x = fminf(ax, fminf(bx, cx)), max_x = fmaxf(ax, fmaxf(bx, cx));
+    float min_y = fminf(ay, fminf(by, cy)), max_y = fmaxf(ay, fmaxf(by, cy));
+
+    int32_t x0 = (int32_t) ceilf(min_x - 0.5), x1 = (int32_t) floorf(max_x - 0.5);
+    int32_t y0 = (int32_t) ceilf(min_y - 0.5), y1 = (int32_t) floorf(max_y - 0.5);
+
+    if(x0 < 0) x0 = 0;
+    if(y0 < 0) y0 = 0;
+    if(x1 >= depth->width) x1 = depth->width - 1;
+    if(y1 >= depth->height) y1 = depth->height - 1;
+
+    float inv_area = 1.0 / area;
+    for(int32_t y = y0; y <= y1; y++) {
+        float py = y + 0.5;
+        float* row = depth->depth + (uint32_t) y * depth->width;
+
+        for(int32_t x = x0; x <= x1; x++) {
+            float px = x + 0.5;
+            float w0 = ((bx - px) * (cy - py) - (by - py) * (cx - px)) * inv_area;
+            float w1 = ((cx - px) * (ay - py) - (cy - py) * (ax - px)) * inv_area;
+            float w2 = 1.0 - w0 - w1;
+
+            if(w0 < 0.0 || w1 < 0.0 || w2 < 0.0)
+                continue;
+
+            float z = w0 * za + w1 * zb + w2 * zc;
+            if(z > row[x])
+                row[x] = z;
+        }
+    }
+}
+
+static void goblin3d_render_hidden_edge(goblin3d_obj_t* obj, goblin3d_depth_t* depth,
+    uint32_t edge, float bias, goblin3d_obj_draw_fn draw) {
+    uint32_t start = obj->edges[edge][0], end = obj->edges[edge][1];
+    float x0 = obj->points[start][0], y0 = obj->points[start][1];
+    float x1 = obj->points[end][0], y1 = obj->points[end][1];
+    float z0 = obj->rotated_points[start][2], z1 = obj->rotated_points[end][2];
+
+    float scale = 1.0 / (1 << depth->shift);
+    float span = fmaxf(fabsf(x1 - x0), fabsf(y1 - y0)) * scale;
+    uint32_t steps = (uint32_t) ceilf(span);
+    if(steps < 1)
+        steps = 1;
+
+    int32_t run_start = -1;
+    for(uint32_t i = 0; i <= steps; i++) {
+        float t = (float) i / steps;
+        int32_t cx = (int32_t) floorf((x0 + (x1 - x0) * t) * scale);
+        int32_t cy = (int32_t) floorf((y0 + (y1 - y0) * t) * scale);
+
+        bool visible = true;
+        if(cx >= 0 && cy >= 0 && cx < depth->width && cy < depth->height)
+            visible = z0 + (z1 - z0) * t + bias >=
+                depth->depth[(uint32_t) cy * depth->width + cx];
+
+        if(visible && run_start < 0)
+            run_start = i;
+
+        if(run_start >= 0 && (!visible || i == steps)) {
+            uint32_t run_end = visible ? i : i - 1;
+            float t0 = (float) run_start / steps, t1 = (float) run_end / steps;
+
+            draw(
+                roundf(x0 + (x1 - x0) * t0),
+                roundf(y0 + (y1 - y0) * t0),
+                roundf(x0 + (x1 - x0) * t1),
+                roundf(y0 + (y1 - y0) * t1)
+            );
+            run_start = -1;
+        }
+    }
+}
+
+void goblin3d_render_hidden(goblin3d_obj_t* obj, goblin3d_depth_t* depth, goblin3d_obj_draw_fn draw) {
+    if(obj->culled)
+        return;
+
+    if(obj->face_count == 0 || !obj->edge_flags) {
+        goblin3d_render(obj, draw);
+        return;
+    }
+    goblin3d_transform_full(obj);
+
+    uint32_t cells = (uint32_t) depth->width * depth->height;
+    for(uint32_t i = 0; i < cells; i++)
+        depth->depth[i] = -INFINITY;
+
+    float min_z = INFINITY, max_z = -INFINITY;
+    for(uint32_t i = 0; i < obj->point_count; i++) {
+        float z = obj->rotated_points[i][2];
+
+        if(z < min_z) min_z = z;
+        if(z > max_z) max_z = z;
+    }
+
+    for(uint32_t i = 0; i < obj->face_count; i++) {
+        uint32_t* face = obj->faces[i];
+        goblin3d_depth_raster(
+            depth,
+            obj->points[face[0]],
+            obj->points[face[1]],
+            obj->points[face[2]],
+            obj->rotated_points[face[0]][2],
+            obj->rotated_points[face[1]][2],
+            obj->rotated_points[face[2]][2]
+        );
+    }
+
+    bool cull = obj->render_flags & GOBLIN3D_RENDER_CULL_BACKFACES;
+    if(cull)
+        goblin3d_mark_front_edges(obj);
+
+    float bias = depth->bias * (max_z - min_z);
+    for(uint32_t i = 0; i < obj->edge_count; i++) {
+        if(cull && goblin3d_edge_culled(obj, i))
+            continue;
+
+        goblin3d_render_hidden_edge(obj, depth, i, bias, draw);
+    }
+}
+
+bool goblin3d_framebuffer_init(goblin3d_framebuffer_t* fb, uint16_t width, uint16_t height, bool with_depth) {
+    uint32_t size = (uint32_t) width * height;
+
+    fb->width = width;
+    fb->height = height;
+    fb->depth = NULL;
+
+    fb->pixels = (uint16_t*) malloc(sizeof(uint16_t) * size);
+    if(!fb->pixels)
+        return false;
+
+    if(with_depth) {
+        fb->depth = (float*) malloc(sizeof(float) * size);
+        if(!fb->depth) {
+            goblin3d_framebuffer_free(fb);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void goblin3d_framebuffer_free(goblin3d_framebuffer_t* fb) {
+    if(fb->pixels)
+        free(fb->pixels);
+
+    if(fb->depth)
+        free(fb->depth);
+
+    fb->pixels = NULL;
+    fb->depth = NULL;
+}
+
+void goblin3d_framebuffer_clear(goblin3d_framebuffer_t* fb, uint16_t color) {
+    uint32_t size = (uint32_t) fb->width * fb->height;
+
+    for(uint32_t i = 0; i < size; i++)
+        fb->pixels[i] = color;
+
+    if(fb->depth)
+        for(uint32_t i = 0; i < size; i++)
+            fb->depth[i] = -INFINITY;
+}
+
+typedef struct {
+    goblin3d_framebuffer_t* fb;
+    goblin3d_obj_span_fn span;
+    uint16_t width;
+    uint16_t height;
+} goblin3d_fill_target_t;
+
+static inline int64_t goblin3d_floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    if((a % b != 0) && ((a < 0) != (b < 0)))
+        q--;
+
+    return q;
+}
+
+static void goblin3d_fill_triangle(goblin3d_fill_target_t* target, const float* pa, const float* pb,
+    const float* pc, float za, float zb, float zc, uint16_t color) {
+    int32_t x[3] = { (int32_t) lroundf(pa[0]), (int32_t) lroundf(pb[0]), (int32_t) lroundf(pc[0]) };
+    int32_t y[3] = { (int32_t) lroundf(pa[1]), (int32_t) lroundf(pb[1]), (int32_t) lroundf(pc[1]) };
+    float z[3] = { za, zb, zc };
+
+    int64_t area = (int64_t) (x[1] - x[0]) * (y[2] - y[0]) -
+        (int64_t) (y[1] - y[0]) * (x[2] - x[0]);
+    if(area == 0)
+        return;
+
+    if(area < 0) {
+        int32_t ti = x[1]; x[1] = x[2]; x[2] = ti;
+        ti = y[1]; y[1] = y[2]; y[2] = ti;
+
+        float tz = z[1]; z[1] = z[2]; z[2] = tz;
+        area = -area;
+    }
+
+    int32_t min_x = x[0] < x[1] ? (x[0] < x[2] ? x[0] : x[2]) : (x[1] < x[2] ? x[1] : x[2]);
+    int32_t max_x = x[0] > x[1] ? (x[0] > x[2] ? x[0] : x[2]) : (x[1] > x[2] ? x[1] : x[2]);
+    int32_t min_y = y[0] < y[1] ? (y[0] < y[2] ? y[0] : y[2]) : (y[1] < y[2] ? y[1] : y[2]);
+    int32_t max_y = y[0] > y[1] ? (y[0] > y[2] ? y[0] : y[2]) : (y[1] > y[2] ? y[1] : y[2]);
+
+    if(min_x < 0) min_x = 0;
+    if(min_y < 0) min_y = 0;
+    if(max_x >= target->width) max_x = target->width - 1;
+    if(max_y >= target->height) max_y = target->height - 1;
+    if(min_x > max_x || min_y > max_y)
+        return;
+
+    int64_t edge_dx[3], edge_dy[3], bias[3];
+    for(uint8_t i = 0; i < 3; i++) {
+        uint8_t j = (i + 1) % 3;
+
+        edge_dx[i] = x[j] - x[i];
+        edge_dy[i] = y[j] - y[i];
+        bias[i] = (edge_dy[i] < 0 || (edge_dy[i] == 0 && edge_dx[i] > 0)) ? 0 : 1;
+    }
+
+    float dzdx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+    float dzdy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+
+    for(int32_t row = min_y; row <= max_y; row++) {
+        int64_t lo = min_x, hi = max_x;
+
+        for(uint8_t i = 0; i < 3 && lo <= hi; i++) {
+            int64_t a = -edge_dy[i];
+            int64_t r = bias[i] - edge_dx[i] * (row - y[i]) + a * x[i];
+
+            if(a > 0) {
+                int64_t bound = -goblin3d_floor_div(-r, a);
+                if(bound > lo)
+                    lo = bound;
+            }
+            else if(a < 0) {
+                int64_t bound = goblin3d_floor_div(r, a);
+                if(bound < hi)
+                    hi = bound;
+            }
+            else if(r > 0)
+                hi = lo - 1;
+        }
+
+        if(lo > hi)
+            continue;
+
+        if(target->span) {
+            target->span(lo, row, hi - lo + 1, color);
+            continue;
+        }
+
+        uint16_t* pixels = target->fb->pixels + (uint32_t) row * target->fb->width;
+        if(!target->fb->depth) {
+            for(int64_t col = lo; col <= hi; col++)
+                pixels[col] = color;
+            continue;
+        }
+
+        float* depth = target->fb->depth + (uint32_t) row * target->fb->width;
+        float depth_z = z[0] + dzdx * (lo - x[0]) + dzdy * (row - y[0]);
+
+        for(int64_t col = lo; col <= hi; col++, depth_z += dzdx)
+            if(depth_z > depth[col]) {
+                depth[col] = depth_z;
+                pixels[col] = color;
+            }
+    }
+}
+
+static inline uint16_t goblin3d_scale_color(uint16_t color, float intensity) {
+    uint16_t r = ((color >> 11) & 0x1F) * intensity;
+    uint16_t g = ((color >> 5) & 0x3F) * intensity;
+    uint16_t b = (color & 0x1F) * intensity;
+
+    return (r << 11) | (g << 5) | b;
+}
+
+static uint16_t goblin3d_shade_face(goblin3d_obj_t* obj, uint32_t face, bool back,
+    const goblin3d_shading_t* shading) {
+    float* a = obj->rotated_points[obj->faces[face][0]];
+    float* b = obj->rotated_points[obj->faces[face][1]];
+    float* c = obj->rotated_points[obj->faces[face][2]];
+
+    float ux = b[0] - a[0], uy = b[1] - a[1], uz = b[2] - a[2];
+    float vx = c[0] - a[0], vy = c[1] - a[1], vz = c[2] - a[2];
+
+    float nx = uy * vz - uz * vy;
+    float ny = uz * vx - ux * vz;
+    float nz = ux * vy - uy * vx;
+
+    float length = sqrtf(nx * nx + ny * ny + nz * nz);
+    float lambert = 0.0;
+
+    if(length > 0.0) {
+        lambert = (nx * shading->light[0] + ny * shading->light[1] + nz * shading->light[2]) / length;
+        if(back)
+            lambert = -lambert;
+
+        if(lambert < 0.0)
+            lambert = 0.0;
+    }
+
+    return goblin3d_scale_color(shading->color, shading->ambient + (1.0 - shading->ambient) * lambert);
+}
+
+static inline float goblin3d_face_depth(goblin3d_obj_t* obj, uint32_t face) {
+    return obj->rotated_points[obj->faces[face][0]][2] +
+        obj->rotated_points[obj->faces[face][1]][2] +
+        obj->rotated_points[obj->faces[face][2]][2];
+}
+
+static bool goblin3d_sort_faces(goblin3d_obj_t* obj) {
+    if(!obj->face_order) {
+        obj->face_order = (uint32_t*) malloc(obj->face_count * sizeof(uint32_t));
+        if(!obj->face_order)
+            return false;
+
+        for(uint32_t i = 0; i < obj->face_count; i++)
+            obj->face_order[i] = i;
+    }
+
+    for(uint32_t i = 1; i < obj->face_count; i++) {
+        uint32_t face = obj->face_order[i];
+        float depth = goblin3d_face_depth(obj, face);
+
+        uint32_t j = i;
+        while(j > 0 && goblin3d_face_depth(obj, obj->face_order[j - 1]) > depth) {
+            obj->face_order[j] = obj->face_order[j - 1];
+            j--;
+        }
+
+        obj->face_order[j] = face;
+    }
+
+    return true;
+}
+
+static bool goblin3d_render_fill(goblin3d_obj_t* obj, goblin3d_fill_target_t* target,
+    const goblin3d_shading_t* shading, bool sorted) {
+    if(obj->face_count == 0 || obj->culled)
+        return true;
+    goblin3d_transform_full(obj);
+
+    if(sorted && !goblin3d_sort_faces(obj))
+        return false;
+
+    bool cull = obj->render_flags & GOBLIN3D_RENDER_CULL_BACKFACES;
+    for(uint32_t i = 0; i < obj->face_count; i++) {
+        uint32_t face = sorted ? obj->face_order[i] : i;
+        uint32_t* indices = obj->faces[face];
+
+        float* a = obj->points[indices[0]];
+        float* b = obj->points[indices[1]];
+        float* c = obj->points[indices[2]];
+
+        float winding = (b[0] - a[0]) * (c[1] - a[1]) -
+            (b[1] - a[1]) * (c[0] - a[0]);
+        if(winding == 0.0 || (cull && winding < 0.0))
+            continue;
+
+        goblin3d_fill_triangle(
+            target, a, b, c,
+            obj->rotated_points[indices[0]][2],
+            obj->rotated_points[indices[1]][2],
+            obj->rotated_points[indices[2]][2],
+            goblin3d_shade_face(obj, face, winding < 0.0, shading)
+        );
+    }
+
+    return true;
+}
+
+bool goblin3d_render_filled(goblin3d_obj_t* obj, goblin3d_framebuffer_t* fb, const goblin3d_shading_t* shading) {
+    goblin3d_fill_target_t target = { fb, NULL, fb->width, fb->height };
+    return goblin3d_render_fill(obj, &target, shading, fb->depth == NULL);
+}
+
+bool goblin3d_render_filled_spans(goblin3d_obj_t* obj, uint16_t width, uint16_t height,
+    const goblin3d_shading_t* shading, goblin3d_obj_span_fn span) {
+    goblin3d_fill_target_t target = { NULL, span, width, height };
+    return goblin3d_render_fill(obj, &target, shading, true);
+}
+
+bool goblin3d_occupancy_init(goblin3d_occupancy_t* occupancy, uint16_t screen_width, uint16_t screen_height, uint8_t shift) {
+    uint16_t cell = 1 << shift;
+
+    occupancy->shift = shift;
+    occupancy->width = (screen_width + cell - 1) >> shift;
+    occupancy->height = (screen_height + cell - 1) >> shift;
+
+    uint32_t words = ((uint32_t) occupancy->width * occupancy->height + 31) >> 5;
+    occupancy->bits = (uint32_t*) malloc(sizeof(uint32_t) * words);
+    return occupancy->bits != NULL;
+}
+
+void goblin3d_occupancy_free(goblin3d_occupancy_t* occupancy) {
+    if(occupancy->bits)
+        free(occupancy->bits);
+    occupancy->bits = NULL;
+}
+
+static inline bool goblin3d_occupy(goblin3d_occupancy_t* occupancy, uint16_t x, uint16_t y) {
+    uint32_t cell = (uint32_t) (y >> occupancy->shift) * occupancy->width + (x >> occupancy->shift);
+    uint32_t mask = 1u << (cell & 31);
+
+    if(occupancy->bits[cell >> 5] & mask)
+        return false;
+
+    occupancy->bits[cell >> 5] |= mask;
+    return true;
+}
+
+static inline uint32_t goblin3d_visible_points(goblin3d_obj_t* obj, const uint32_t** indices) {
+    if(obj->lod_level > 0) {
+        goblin3d_lod_t* lod = &obj->lods[obj->lod_level - 1];
+
+        *indices = lod->point_indices;
+        return lod->point_count;
+    }
+
+    *indices = NULL;
+    return obj->point_count;
+}
+
+void goblin3d_render_points(goblin3d_obj_t* obj, uint16_t width, uint16_t height,
+    goblin3d_occupancy_t* occupancy, goblin3d_obj_points_fn plot) {
+    uint16_t xy[GOBLIN3D_POINT_BATCH * 2];
+    if(obj->culled)
+        return;
+
+    if(occupancy)
+        memset(occupancy->bits, 0,
+            sizeof(uint32_t) * (((uint32_t) occupancy->width * occupancy->height + 31) >> 5));
+
+    const uint32_t* indices;
+    uint32_t total = goblin3d_visible_points(obj, &indices);
+    uint32_t count = 0;
+
+    for(uint32_t i = 0; i < total; i++) {
+        float* point = obj->points[indices ? indices[i] : i];
+        if(point[0] < 0.0 || point[1] < 0.0 || point[0] >= width || point[1] >= height)
+            continue;
+
+        uint16_t x = point[0], y = point[1];
+        if(occupancy && !goblin3d_occupy(occupancy, x, y))
+            continue;
+
+        xy[count * 2] = x;
+        xy[count * 2 + 1] = y;
+
+        if(++count == GOBLIN3D_POINT_BATCH) {
+            plot(xy, count);
+            count = 0;
+        }
+    }
+
+    if(count > 0)
+        plot(xy, count);
+}
+
+void goblin3d_render_points_fb(goblin3d_obj_t* obj, goblin3d_framebuffer_t* fb, uint16_t color, float min_intensity) {
+    uint16_t palette[GOBLIN3D_POINT_SHADES];
+    if(obj->culled)
+        return;
+
+    if(!obj->bounds_valid)
+        goblin3d_update_bounds(obj);
+
+    goblin3d_rotation_t rotation;
+    goblin3d_rotation(obj, &rotation);
+
+    float x = obj->bound_center[0];
+    float y = obj->bound_center[1];
+    float z = obj->bound_center[2];
+    goblin3d_rotate(&rotation, &x, &y, &z);
+
+    float far_z = z + obj->z_offset - obj->bound_radius;
+    float shade_scale = obj->bound_radius > 0.0 ?
+        (GOBLIN3D_POINT_SHADES - 1) / (2.0 * obj->bound_radius) : 0.0;
+
+    for(uint8_t i = 0; i < GOBLIN3D_POINT_SHADES; i++)
+        palette[i] = goblin3d_scale_color(color,
+            min_intensity + (1.0 - min_intensity) * i / (GOBLIN3D_POINT_SHADES - 1));
+
+    const uint32_t* indices;
+    uint32_t total = goblin3d_visible_points(obj, &indices);
+
+    for(uint32_t i = 0; i < total; i++) {
+        uint32_t index = indices ? indices[i] : i;
+        float* point = obj->points[index];
+        if(point[0] < 0.0 || point[1] < 0.0 || point[0] >= fb->width || point[1] >= fb->height)
+            continue;
+
+        uint32_t pixel = (uint32_t) point[1] * fb->width + (uint32_t) point[0];
+        float depth_z = obj->rotated_points[index][2];
+
+        if(fb->depth) {
+            if(depth_z <= fb->depth[pixel])
+                continue;
+            fb->depth[pixel] = depth_z;
+        }
+
+        int32_t shade = shade_scale > 0.0 ? (depth_z - far_z) * shade_scale : GOBLIN3D_POINT_SHADES - 1;
+        if(shade < 0)
+            shade = 0;
+        else if(shade >= GOBLIN3D_POINT_SHADES)
+            shade = GOBLIN3D_POINT_SHADES - 1;
+
+        fb->pixels[pixel] = palette[shade];
+    }
+}
+
+bool goblin3d_bake_animation(const goblin3d_obj_t* obj, const goblin3d_keyframe_t* keyframes, uint32_t count,
+    goblin3d_animation_t* animation) {
+    size_t size = sizeof(int16_t[2]) * obj->point_count * (size_t) count;
+
+    animation->points = (int16_t(*)[2]) malloc(size > 0 ? size : 1);
+    animation->point_count = obj->point_count;
+    animation->frame_count = count;
+    animation->borrowed = false;
+
+    if(!animation->points)
+        return false;
+
+    int16_t (*baked)[2] = animation->points;
+    for(uint32_t frame = 0; frame < count; frame++) {
+        goblin3d_rotation_t rotation;
+        goblin3d_rotation_angles(keyframes[frame].x_angle_deg, keyframes[frame].y_angle_deg,
+            keyframes[frame].z_angle_deg, &rotation);
+
+        for(uint32_t i = 0; i < obj->point_count; i++, baked++) {
+            float rotated[3], projected[2];
+            goblin3d_project_point(obj, &rotation, i, rotated, projected);
+
+            for(uint8_t j = 0; j < 2; j++) {
+                float value = projected[j];
+                (*baked)[j] = value < -32768.0 ? -32768 : (value > 32767.0 ? 32767 : (int16_t) value);
+            }
+        }
+    }
+
+    return true;
+}
+
+void goblin3d_animation_free(goblin3d_animation_t* animation) {
+    if(animation->points && !animation->borrowed)
+        free(animation->points);
+
+    animation->points = NULL;
+    animation->frame_count = 0;
+}
+
+void goblin3d_render_frame(goblin3d_obj_t* obj, const goblin3d_animation_t* animation, uint32_t frame,
+    goblin3d_obj_draw_fn draw) {
+    if(animation->frame_count == 0 || animation->point_count != obj->point_count)
+        return;
+
+    const int16_t (*points)[2] = animation->points +
+        (size_t) (frame % animation->frame_count) * animation->point_count;
+
+    for(uint32_t i = 0; i < obj->edge_count; i++) {
+        uint32_t start = obj->edges[i][0], end = obj->edges[i][1];
+        draw(points[start][0], points[start][1], points[end][0], points[end][1]);
+    }
+}
+
+#ifdef GOBLIN3D_POSIX
+
+typedef struct goblin3d_tile_job goblin3d_tile_job_t;
+
+typedef struct {
+    goblin3d_tile_job_t* job;
+    goblin3d_tiler_t* tiler;
+    uint32_t next;
+    uint32_t end;
+    uint8_t index;
+} goblin3d_tile_worker_t;
+
+struct goblin3d_tile_job {
+    goblin3d_obj_t* obj;
+    goblin3d_tiler_t* tiler;
+    goblin3d_framebuffer_t* fb;
+    goblin3d_tile_worker_t* workers;
+    uint16_t color;
+    bool cull;
+    void (*phase)(goblin3d_tile_worker_t* worker);
+};
+
+static void* goblin3d_tile_thread(void* arg);
+
+bool goblin3d_tiler_init(goblin3d_tiler_t* tiler, uint16_t width, uint16_t height, uint8_t thread_count) {
+    if(thread_count < 1)
+        thread_count = 1;
+
+    tiler->thread_count = thread_count;
+    tiler->tiles_x = (width + GOBLIN3D_TILE_SIZE - 1) / GOBLIN3D_TILE_SIZE;
+    tiler->tiles_y = (height + GOBLIN3D_TILE_SIZE - 1) / GOBLIN3D_TILE_SIZE;
+    tiler->bins = NULL;
+    tiler->bin_capacity = 0;
+    tiler->threads = NULL;
+    tiler->generation = 0;
+    tiler->pending = 0;
+    tiler->stopping = false;
+
+    uint32_t tiles = (uint32_t) tiler->tiles_x * tiler->tiles_y;
+    tiler->counts = (uint32_t*) malloc(sizeof(uint32_t) * tiles * thread_count);
+    tiler->tile_start = (uint32_t*) malloc(sizeof(uint32_t) * (tiles + 1));
+    tiler->workers = malloc(sizeof(goblin3d_tile_worker_t) * thread_count);
+    pthread_t* threads = (pthread_t*) malloc(sizeof(pthread_t) * thread_count);
+
+    if(!tiler->counts || !tiler->tile_start || !tiler->workers || !threads) {
+        free(threads);
+        goblin3d_tiler_free(tiler);
+        return false;
+    }
+
+    goblin3d_tile_worker_t* workers = (goblin3d_tile_worker_t*) tiler->workers;
+    for(uint8_t i = 0; i < thread_count; i++) {
+        workers[i].job = NULL;
+        workers[i].tiler = tiler;
+        workers[i].index = i;
+    }
+
+    pthread_mutex_init(&tiler->lock, NULL);
+    pthread_cond_init(&tiler->start, NULL);
+    pthread_cond_init(&tiler->done, NULL);
+    tiler->threads = threads;
+
+    for(uint8_t i = 1; i < thread_count; i++)
+        if(pthread_create(&threads[i], NULL, goblin3d_tile_thread, &workers[i]) != 0) {
+            tiler->thread_count = i;
+            goblin3d_tiler_free(tiler);
+            return false;
+        }
+
+    return true;
+}
+
+void goblin3d_tiler_free(goblin3d_tiler_t* tiler) {
+    if(tiler->threads) {
+        pthread_mutex_lock(&tiler->lock);
+        tiler->stopping = true;
+        pthread_cond_broadcast(&tiler->start);
+        pthread_mutex_unlock(&tiler->lock);
+
+        for(uint8_t i = 1; i < tiler->thread_count; i++)
+            pthread_join(tiler->threads[i], NULL);
+
+        pthread_cond_destroy(&tiler->done);
+        pthread_cond_destroy(&tiler->start);
+        pthread_mutex_destroy(&tiler->lock);
+        free(tiler->threads);
+    }
+
+    if(tiler->workers)
+        free(tiler->workers);
+
+    if(tiler->counts)
+        free(tiler->counts);
+
+    if(tiler->tile_start)
+        free(tiler->tile_start);
+
+    if(tiler->bins)
+        free(tiler->bins);
+
+    tiler->threads = NULL;
+    tiler->workers = NULL;
+    tiler->counts = NULL;
+    tiler->tile_start = NULL;
+    tiler->bins = NULL;
+    tiler->bin_capacity = 0;
+}
+
+static inline void goblin3d_edge_coords(goblin3d_obj_t* obj, uint32_t edge, int32_t* coords) {
+    uint32_t start = obj->edges[edge][0], end = obj->edges[edge][1];
+
+    coords[0] = (int32_t) lroundf(obj->points[start][0]);
+    coords[1] = (int32_t) lroundf(obj->points[start][1]);
+    coords[2] = (int32_t) lroundf(obj->points[end][0]);
+    coords[3] = (int32_t) lroundf(obj->points[end][1]);
+}
+
+static void goblin3d_bin_edge(goblin3d_tiler_t* tiler, uint32_t edge, const int32_t* c,
+    uint32_t* counts, bool fill) {
+    int32_t min_x = c[0] < c[2] ? c[0] : c[2], max_x = c[0] < c[2] ? c[2] : c[0];
+    int32_t min_y = c[1] < c[3] ? c[1] : c[3], max_y = c[1] < c[3] ? c[3] : c[1];
+
+    int32_t tx0 = min_x < 0 ? 0 : min_x / GOBLIN3D_TILE_SIZE;
+    int32_t ty0 = min_y < 0 ? 0 : min_y / GOBLIN3D_TILE_SIZE;
+    int32_t tx1 = max_x < 0 ? -1 : max_x / GOBLIN3D_TILE_SIZE;
+    int32_t ty1 = max_y < 0 ? -1 : max_y / GOBLIN3D_TILE_SIZE;
+
+    if(tx1 >= tiler->tiles_x) tx1 = tiler->tiles_x - 1;
+    if(ty1 >= tiler->tiles_y) ty1 = tiler->tiles_y - 1;
+
+    int64_t dx = c[2] - c[0], dy = c[3] - c[1];
+    for(int32_t ty = ty0; ty <= ty1; ty++)
+        for(int32_t tx = tx0; tx <= tx1; tx++) {
+            if(tx0 != tx1 && ty0 != ty1) {
+                int64_t left = tx * GOBLIN3D_TILE_SIZE - 1, right = left + GOBLIN3D_TILE_SIZE + 1;
+                int64_t top = ty * GOBLIN3D_TILE_SIZE - 1, bottom = top + GOBLIN3D_TILE_SIZE + 1;
+
+                int64_t e0 = dx * (top - c[1]) - dy * (left - c[0]);
+                int64_t e1 = dx * (top - c[1]) - dy * (right - c[0]);
+                int64_t e2 = dx * (bottom - c[1]) - dy * (left - c[0]);
+                int64_t e3 = dx * (bottom - c[1]) - dy * (right - c[0]);
+
+                if((e0 > 0 && e1 > 0 && e2 > 0 && e3 > 0) ||
+                    (e0 < 0 && e1 < 0 && e2 < 0 && e3 < 0))
+                    continue;
+            }
+
+            uint32_t tile = (uint32_t) ty * tiler->tiles_x + tx;
+            if(fill)
+                tiler->bins[counts[tile]++] = edge;
+            else counts[tile]++;
+        }
+}
+
+static void goblin3d_tile_bin_phase(goblin3d_tile_worker_t* worker, bool fill) {
+    goblin3d_tile_job_t* job = worker->job;
+    goblin3d_tiler_t* tiler = job->tiler;
+
+    uint32_t tiles = (uint32_t) tiler->tiles_x * tiler->tiles_y;
+    uint32_t* counts = tiler->counts + (uint32_t) worker->index * tiles;
+    uint32_t edges = job->obj->edge_count;
+
+    uint32_t begin = (uint64_t) edges * worker->index / tiler->thread_count;
+    uint32_t end = (uint64_t) edges * (worker->index + 1) / tiler->thread_count;
+
+    if(!fill)
+        memset(counts, 0, sizeof(uint32_t) * tiles);
+
+    for(uint32_t i = begin; i < end; i++) {
+        if(job->cull && goblin3d_edge_culled(job->obj, i))
+            continue;
+
+        int32_t coords[4];
+        goblin3d_edge_coords(job->obj, i, coords);
+        goblin3d_bin_edge(tiler, i, coords, counts, fill);
+    }
+}
+
+static void goblin3d_tile_count_phase(goblin3d_tile_worker_t* worker) {
+    goblin3d_tile_bin_phase(worker, false);
+}
+
+static void goblin3d_tile_fill_phase(goblin3d_tile_worker_t* worker) {
+    goblin3d_tile_bin_phase(worker, true);
+}
+
+static void goblin3d_raster_tile(goblin3d_tile_job_t* job, uint32_t tile) {
+    goblin3d_tiler_t* tiler = job->tiler;
+    goblin3d_framebuffer_t* fb = job->fb;
+
+    int32_t left = (tile % tiler->tiles_x) * GOBLIN3D_TILE_SIZE;
+    int32_t top = (tile / tiler->tiles_x) * GOBLIN3D_TILE_SIZE;
+    int32_t right = left + GOBLIN3D_TILE_SIZE - 1, bottom = top + GOBLIN3D_TILE_SIZE - 1;
+
+    if(right >= fb->width) right = fb->width - 1;
+    if(bottom >= fb->height) bottom = fb->height - 1;
+
+    for(uint32_t i = tiler->tile_start[tile]; i < tiler->tile_start[tile + 1]; i++) {
+        int32_t c[4];
+        goblin3d_edge_coords(job->obj, tiler->bins[i], c);
+
+        int64_t dx = c[2] - c[0], dy = c[3] - c[1];
+        bool steep = (dy < 0 ? -dy : dy) > (dx < 0 ? -dx : dx);
+
+        int32_t major0 = steep ? c[1] : c[0], minor0 = steep ? c[0] : c[1];
+        int32_t major1 = steep ? c[3] : c[2];
+        int64_t d_major = steep ? dy : dx, d_minor = steep ? dx : dy;
+
+        if(d_major < 0) {
+            major0 = major1;
+            minor0 = steep ? c[2] : c[3];
+            d_major = -d_major;
+            d_minor = -d_minor;
+        }
+
+        int32_t lo = steep ? top : left, hi = steep ? bottom : right;
+        int32_t minor_lo = steep ? left : top, minor_hi = steep ? right : bottom;
+
+        int32_t first = major0 > lo ? major0 : lo;
+        int32_t last = major0 + d_major < hi ? major0 + d_major : hi;
+        if(first > last)
+            continue;
+
+        if(d_major == 0) {
+            if(minor0 >= minor_lo && minor0 <= minor_hi)
+                fb->pixels[(uint32_t) (steep ? major0 : minor0) * fb->width +
+                    (steep ? minor0 : major0)] = job->color;
+            continue;
+        }
+
+        int64_t denom = 2 * d_major;
+        int64_t numer = 2 * (int64_t) (first - major0) * d_minor + d_major;
+        int64_t minor = minor0 + goblin3d_floor_div(numer, denom);
+        int64_t rem = numer - (minor - minor0) * denom;
+
+        for(int32_t major = first; major <= last; major++) {
+            if(minor >= minor_lo && minor <= minor_hi) {
+                if(steep)
+                    fb->pixels[(uint32_t) major * fb->width + minor] = job->color;
+                else fb->pixels[(uint32_t) minor * fb->width + major] = job->color;
+            }
+
+            rem += 2 * d_minor;
+            if(rem >= denom) {
+                rem -= denom;
+                minor++;
+            }
+            else if(rem < 0) {
+                rem += denom;
+                minor--;
+            }
+        }
+    }
+}
+
+static void goblin3d_tile_raster_phase(goblin3d_tile_worker_t* worker) {
+    goblin3d_tile_job_t* job = worker->job;
+    uint8_t count = job->tiler->thread_count;
+
+    for(uint8_t i = 0; i < count; i++) {
+        goblin3d_tile_worker_t* victim = &job->workers[(worker->index + i) % count];
+
+        while(true) {
+            uint32_t tile = __atomic_fetch_add(&victim->next, 1, __ATOMIC_RELAXED);
+            if(tile >= victim->end)
+                break;
+
+            goblin3d_raster_tile(job, tile);
+        }
+    }
+}
+
+static void* goblin3d_tile_thread(void* arg) {
+    goblin3d_tile_worker_t* worker = (goblin3d_tile_worker_t*) arg;
+    goblin3d_tiler_t* tiler = worker->tiler;
+    uint32_t generation = 0;
+
+    pthread_mutex_lock(&tiler->lock);
+    while(true) {
+        while(tiler->generation == generation && !tiler->stopping)
+            pthread_cond_wait(&tiler->start, &tiler->lock);
+
+        if(tiler->stopping)
+            break;
+
+        generation = tiler->generation;
+        pthread_mutex_unlock(&tiler->lock);
+
+        worker->job->phase(worker);
+
+        pthread_mutex_lock(&tiler->lock);
+        if(--tiler->pending == 0)
+            pthread_cond_signal(&tiler->done);
+    }
+    pthread_mutex_unlock(&tiler->lock);
+
+    return NULL;
+}
+
+static void goblin3d_tile_run(goblin3d_tile_job_t* job, void (*phase)(goblin3d_tile_worker_t*)) {
+    goblin3d_tiler_t* tiler = job->tiler;
+    job->phase = phase;
+
+    pthread_mutex_lock(&tiler->lock);
+    tiler->pending = tiler->thread_count - 1;
+    tiler->generation++;
+    pthread_cond_broadcast(&tiler->start);
+    pthread_mutex_unlock(&tiler->lock);
+
+    phase(&job->workers[0]);
+
+    pthread_mutex_lock(&tiler->lock);
+    while(tiler->pending > 0)
+        pthread_cond_wait(&tiler->done, &tiler->lock);
+    pthread_mutex_unlock(&tiler->lock);
+}
+
+bool goblin3d_render_tiled(goblin3d_obj_t* obj, goblin3d_tiler_t* tiler, goblin3d_framebuffer_t* fb, uint16_t color) {
+    if(obj->culled)
+        return true;
+    goblin3d_transform_full(obj);
+
+    goblin3d_tile_worker_t* workers = (goblin3d_tile_worker_t*) tiler->workers;
+    goblin3d_tile_job_t job = {
+        obj, tiler, fb, workers, color,
+        (obj->render_flags & GOBLIN3D_RENDER_CULL_BACKFACES) &&
+            obj->face_count > 0 && obj->edge_flags,
+        NULL
+    };
+
+    uint8_t count = tiler->thread_count;
+    for(uint8_t i = 0; i < count; i++)
+        workers[i].job = &job;
+
+    if(job.cull)
+        goblin3d_mark_front_edges(obj);
+
+    goblin3d_tile_run(&job, goblin3d_tile_count_phase);
+
+    uint32_t tiles = (uint32_t) tiler->tiles_x * tiler->tiles_y;
+    uint32_t total = 0;
+
+    for(uint32_t tile = 0; tile < tiles; tile++) {
+        tiler->tile_start[tile] = total;
+
+        for(uint8_t i = 0; i < count; i++) {
+            uint32_t* counts = tiler->counts + (uint32_t) i * tiles;
+            uint32_t binned = counts[tile];
+
+            counts[tile] = total;
+            total += binned;
+        }
+    }
+    tiler->tile_start[tiles] = total;
+
+    if(total > tiler->bin_capacity) {
+        uint32_t* bins = (uint32_t*) realloc(tiler->bins, sizeof(uint32_t) * total);
+        if(!bins)
+            return false;
+
+        tiler->bins = bins;
+        tiler->bin_capacity = total;
+    }
+
+    goblin3d_tile_run(&job, goblin3d_tile_fill_phase);
+
+    for(uint8_t i = 0; i < count; i++) {
+        workers[i].next = (uint64_t) tiles * i / count;
+        workers[i].end = (uint64_t) tiles * (i + 1) / count;
+    }
+
+    goblin3d_tile_run(&job, goblin3d_tile_raster_phase);
+    return true;
+}
+
+#endif
+
+static inline uint32_t goblin3d_edge_hash(uint32_t v1, uint32_t v2, uint8_t bits) {
+    uint64_t key = v1 < v2 ? ((uint64_t) v1 << 32) | v2 : ((uint64_t) v2 << 32) | v1;
+    return (uint32_t) ((key * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+static uint32_t* goblin3d_hash_edges(const uint32_t (*edges)[2], uint32_t edge_count, uint8_t bits) {
+    uint32_t size = (uint32_t) 1 << bits;
+
+    uint32_t* table = (uint32_t*) malloc(sizeof(uint32_t) * size);
+    if(!table)
+        return NULL;
+    memset(table, 0xFF, sizeof(uint32_t) * size);
+
+    for(uint32_t i = 0; i < edge_count; i++) {
+        uint32_t slot = goblin3d_edge_hash(edges[i][0], edges[i][1], bits);
+        while(table[slot] != GOBLIN3D_NO_EDGE)
+            slot = (slot + 1) & (size - 1);
+
+        table[slot] = i;
+    }
+
+    return table;
+}
+
+bool goblin3d_add_point(goblin3d_obj_t* obj, float x, float y, float z) {
+    if(obj->borrowed && !goblin3d_own(obj))
+        return false;
+    goblin3d_free_strips(obj);
+    goblin3d_free_lods(obj);
+
+    obj->point_count++;
+
+    obj->orig_points = (float(*)[3]) realloc(obj->orig_points, obj->point_count * sizeof(float[3]));
+    if(obj->orig_points == NULL)
+        return false;
+
+    obj->rotated_points = (float(*)[3]) realloc(obj->rotated_points, obj->point_count * sizeof(float[3]));
+    if(obj->rotated_points == NULL)
+        return false;
+
+    obj->points = (float(*)[2]) realloc(obj->points, obj->point_count * sizeof(float[2]));
+    if(obj->points == NULL)
+        return false;
+
+    obj->orig_points[obj->point_count - 1][0] = x;
+    obj->orig_points[obj->point_count - 1][1] = y;
+    obj->orig_points[obj->point_count - 1][2] = z;
+    obj->bounds_valid = false;
+
+    return true;
+}
+
+static uint32_t goblin3d_find_edge(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2, uint32_t* slot) {
+    if(obj->edge_table) {
+        uint32_t mask = ((uint32_t) 1 << obj->edge_table_bits) - 1;
+
+        for(*slot = goblin3d_edge_hash(v1, v2, obj->edge_table_bits); obj->edge_table[*slot] != GOBLIN3D_NO_EDGE;
+            *slot = (*slot + 1) & mask) {
+            uint32_t* existing = obj->edges[obj->edge_table[*slot]];
+
+            if((existing[0] == v1 && existing[1] == v2) ||
+                (existing[0] == v2 && existing[1] == v1))
+                return obj->edge_table[*slot];
+        }
+
+        return GOBLIN3D_NO_EDGE;
+    }
+
+    for(uint32_t i = 0; i < obj->edge_count; ++i) {
+        uint32_t existing_v1 = obj->edges[i][0],
+            existing_v2 = obj->edges[i][1];
+        if((existing_v1 == v1 && existing_v2 == v2) ||
+            (existing_v1 == v2 && existing_v2 == v1))
+            return i;
+    }
+
+    return GOBLIN3D_NO_EDGE;
+}
+
+static bool goblin3d_index_edges(goblin3d_obj_t* obj) {
+    uint64_t needed = ((uint64_t) obj->edge_count + 1) * 2;
+    if(obj->edge_table && needed <= ((uint64_t) 1 << obj->edge_table_bits))
+        return true;
+
+    uint8_t bits = 10;
+    while(((uint64_t) 1 << bits) < needed)
+        bits++;
+
+    uint32_t* table = goblin3d_hash_edges(obj->edges, obj->edge_count, bits);
+    if(!table)
+        return false;
+
+    goblin3d_free_edge_table(obj);
+    obj->edge_table = table;
+    obj->edge_table_bits = bits;
+
+    return true;
+}
+
+static bool goblin3d_append_edge(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2, uint32_t slot) {
+    goblin3d_free_strips(obj);
+    goblin3d_free_lods(obj);
+
+    obj->edge_count++;
+    obj->edges = (uint32_t(*)[2]) realloc(obj->edges, obj->edge_count * sizeof(uint32_t[2]));
+    if(obj->edges == NULL)
+        return false;
+
+    obj->edges[obj->edge_count - 1][0] = v1;
+    obj->edges[obj->edge_count - 1][1] = v2;
+
+    if(obj->edge_flags) {
+        obj->edge_flags = (uint8_t*) realloc(obj->edge_flags, obj->edge_count);
+        if(obj->edge_flags == NULL)
+            return false;
+
+        obj->edge_flags[obj->edge_count - 1] = 0;
+    }
+
+    if(obj->edge_table)
+        obj->edge_table[slot] = obj->edge_count - 1;
+
+    return true;
+}
+
+bool goblin3d_edge_exists(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2) {
+    uint32_t slot;
+    return goblin3d_find_edge(obj, v1, v2, &slot) != GOBLIN3D_NO_EDGE;
+}
+
+bool goblin3d_add_edge(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2) {
+    if(obj->borrowed && !goblin3d_own(obj))
+        return false;
+
+    if(obj->edge_table && !goblin3d_index_edges(obj))
+        return false;
+
+    uint32_t slot = 0;
+    if(goblin3d_find_edge(obj, v1, v2, &slot) != GOBLIN3D_NO_EDGE)
+        return true;
+
+    return goblin3d_append_edge(obj, v1, v2, slot);
+}
+
+static uint32_t goblin3d_face_edge(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2) {
+    if(!goblin3d_index_edges(obj))
+        return GOBLIN3D_NO_EDGE;
+
+    uint32_t slot;
+    uint32_t index = goblin3d_find_edge(obj, v1, v2, &slot);
+    if(index != GOBLIN3D_NO_EDGE)
+        return index;
+
+    if(!goblin3d_append_edge(obj, v1, v2, slot))
+        return GOBLIN3D_NO_EDGE;
+    return obj->edge_count - 1;
+}
+
+bool goblin3d_add_face(goblin3d_obj_t* obj, const uint32_t* indices, uint32_t count) {
+    if(obj->borrowed && !goblin3d_own(obj))
+        return false;
+
+    if(count < 3)
+        return false;
+
+    for(uint32_t i = 1; i < count; i++)
+        for(uint32_t j = 0; j < i; j++)
+            if(indices[i] == indices[j])
+                return false;
+
+    if(!obj->edge_flags) {
+        obj->edge_flags = (uint8_t*) calloc(obj->edge_count > 0 ? obj->edge_count : 1, 1);
+        if(obj->edge_flags == NULL)
+            return false;
+    }
+
+    uint32_t first_edge = goblin3d_face_edge(obj, indices[0], indices[1]);
+    if(first_edge == GOBLIN3D_NO_EDGE)
+        return false;
+    obj->edge_flags[first_edge] |= GOBLIN3D_EDGE_HAS_FACE;
+
+    for(uint32_t i = 1; i < count - 1; i++) {
+        uint32_t side = goblin3d_face_edge(obj, indices[i], indices[i + 1]);
+        if(side == GOBLIN3D_NO_EDGE)
+            return false;
+        obj->edge_flags[side] |= GOBLIN3D_EDGE_HAS_FACE;
+
+        uint32_t closing = GOBLIN3D_NO_EDGE;
+        if(i == count - 2) {
+            closing = goblin3d_face_edge(obj, indices[i + 1], indices[0]);
+            if(closing == GOBLIN3D_NO_EDGE)
+                return false;
+            obj->edge_flags[closing] |= GOBLIN3D_EDGE_HAS_FACE;
+        }
+
+        obj->face_count++;
+        obj->faces = (uint32_t(*)[3]) realloc(obj->faces, obj->face_count * sizeof(uint32_t[3]));
+        if(obj->faces == NULL)
+            return false;
+
+        obj->face_edges = (uint32_t(*)[3]) realloc(obj->face_edges, obj->face_count * sizeof(uint32_t[3]));
+        if(obj->face_edges == NULL)
+            return false;
+
+        obj->faces[obj->face_count - 1][0] = indices[0];
+        obj->faces[obj->face_count - 1][1] = indices[i];
+        obj->faces[obj->face_count - 1][2] = indices[i + 1];
+
+        obj->face_edges[obj->face_count - 1][0] = i == 1 ? first_edge : GOBLIN3D_NO_EDGE;
+        obj->face_edges[obj->face_count - 1][1] = side;
+        obj->face_edges[obj->face_count - 1][2] = closing;
+
+        if(obj->face_order) {
+            obj->face_order = (uint32_t*) realloc(obj->face_order, obj->face_count * sizeof(uint32_t));
+            if(obj->face_order == NULL)
+                return false;
+
+            obj->face_order[obj->face_count - 1] = obj->face_count - 1;
+        }
+    }
+
+    return true;
+}
+
+static uint32_t goblin3d_next_strip_edge(uint32_t point, const uint32_t* adjacency_start,
+    const uint32_t* adjacency, uint32_t* next_unused, uint8_t* used) {
+    while(next_unused[point] < adjacency_start[point + 1]) {
+        uint32_t edge = adjacency[next_unused[point]++];
+
+        if(!used[edge]) {
+            used[edge] = 1;
+            return edge;
+        }
+    }
+
+    return GOBLIN3D_NO_EDGE;
+}
+
+bool goblin3d_build_strips(goblin3d_obj_t* obj) {
+    if(obj->borrowed && !goblin3d_own(obj))
+        return false;
+
+    uint32_t point_count = obj->point_count, edge_count = obj->edge_count;
+
+    uint32_t* adjacency_start = (uint32_t*) calloc(point_count + 1, sizeof(uint32_t));
+    uint32_t* next_unused = (uint32_t*) malloc(sizeof(uint32_t) * (point_count + 1));
+    uint32_t* adjacency = (uint32_t*) malloc(sizeof(uint32_t) * (edge_count * 2 + 1));
+    uint8_t* used = (uint8_t*) calloc(edge_count + 1, 1);
+    uint32_t* strip_indices = (uint32_t*) malloc(sizeof(uint32_t) * (edge_count * 2 + 1));
+    uint32_t* strip_offsets = (uint32_t*) malloc(sizeof(uint32_t) * (edge_count + 1));
+
+    if(!adjacency_start || !next_unused || !adjacency || !used || !strip_indices || !strip_offsets) {
+        free(adjacency_start);
+        free(next_unused);
+        free(adjacency);
+        free(used);
+        free(strip_indices);
+        free(strip_offsets);
+
+        return false;
+    }
+
+    for(uint32_t i = 0; i < edge_count; i++) {
+        adjacency_start[obj->edges[i][0] + 1]++;
+        adjacency_start[obj->edges[i][1] + 1]++;
+    }
+
+    for(uint32_t i = 0; i < point_count; i++)
+        adjacency_start[i + 1] += adjacency_start[i];
+
+    memcpy(next_unused, adjacency_start, sizeof(uint32_t) * point_count);
+    for(uint32_t i = 0; i < edge_count; i++) {
+        adjacency[next_unused[obj->edges[i][0]]++] = i;
+        adjacency[next_unused[obj->edges[i][1]]++] = i;
+    }
+    memcpy(next_unused, adjacency_start, sizeof(uint32_t) * point_count);
+
+    uint32_t strip_count = 0, index_count = 0;
+    for(uint8_t pass = 0; pass < 2; pass++)
+        for(uint32_t start = 0; start < point_count; start++) {
+            uint32_t degree = adjacency_start[start + 1] - adjacency_start[start];
+            if(pass == 0 && degree % 2 == 0)
+                continue;
+
+            uint32_t edge;
+            while((edge = goblin3d_next_strip_edge(start, adjacency_start,
+                adjacency, next_unused, used)) != GOBLIN3D_NO_EDGE) {
+                uint32_t current = start;
+
+                strip_offsets[strip_count++] = index_count;
+                strip_indices[index_count++] = start;
+
+                while(edge != GOBLIN3D_NO_EDGE) {
+                    current = obj->edges[edge][0] == current ?
+                        obj->edges[edge][1] : obj->edges[edge][0];
+                    strip_indices[index_count++] = current;
+
+                    edge = goblin3d_next_strip_edge(current, adjacency_start,
+                        adjacency, next_unused, used);
+                }
+            }
+        }
+    strip_offsets[strip_count] = index_count;
+
+    free(adjacency_start);
+    free(next_unused);
+    free(adjacency);
+    free(used);
+
+    if(obj->strip_indices)
+        free(obj->strip_indices);
+
+    if(obj->strip_offsets)
+        free(obj->strip_offsets);
+
+    obj->strip_indices = (uint32_t*) realloc(strip_indices, sizeof(uint32_t) * (index_count + 1));
+    obj->strip_offsets = (uint32_t*) realloc(strip_offsets, sizeof(uint32_t) * (strip_count + 1));
+    obj->strip_count = strip_count;
+
+    if(!obj->strip_indices)
+        obj->strip_indices = strip_indices;
+
+    if(!obj->strip_offsets)
+        obj->strip_offsets = strip_offsets;
+
+    return true;
+}
+
+typedef struct {
+    uint64_t key;
+    uint32_t index;
+} goblin3d_sort_key_t;
+
+static int goblin3d_compare_keys(const void* a, const void* b) {
+    uint64_t key_a = ((const goblin3d_sort_key_t*) a)->key;
+    uint64_t key_b = ((const goblin3d_sort_key_t*) b)->key;
+
+    return key_a < key_b ? -1 : (key_a > key_b ? 1 : 0);
+}
+
+static int goblin3d_compare_indices(const void* a, const void* b) {
+    uint32_t index_a = *(const uint32_t*) a, index_b = *(const uint32_t*) b;
+    return index_a < index_b ? -1 : (index_a > index_b ? 1 : 0);
+}
+
+bool goblin3d_optimize(goblin3d_obj_t* obj) {
+    if(obj->borrowed && !goblin3d_own(obj))
+        return false;
+
+    uint32_t point_count = obj->point_count, edge_count = obj->edge_count,
+        face_count = obj->face_count;
+    uint32_t key_count = edge_count > face_count ? edge_count : face_count;
+
+    uint32_t* remap = (uint32_t*) malloc(sizeof(uint32_t) * (point_count + edge_count));
+    goblin3d_sort_key_t* keys = (goblin3d_sort_key_t*) malloc(sizeof(goblin3d_sort_key_t) * (key_count + 1));
+
+    float (*orig_points)[3] = (float(*)[3]) malloc(sizeof(float[3]) * (point_count + 1));
+    float (*rotated_points)[3] = (float(*)[3]) malloc(sizeof(float[3]) * (point_count + 1));
+    float (*points)[2] = (float(*)[2]) malloc(sizeof(float[2]) * (point_count + 1));
+    uint32_t (*edges)[2] = (uint32_t(*)[2]) malloc(sizeof(uint32_t[2]) * (edge_count + 1));
+
+    uint8_t* edge_flags = obj->edge_flags ? (uint8_t*) malloc(edge_count + 1) : NULL;
+    uint32_t (*faces)[3] = face_count ? (uint32_t(*)[3]) malloc(sizeof(uint32_t[3]) * face_count) : NULL;
+    uint32_t (*face_edges)[3] = face_count ? (uint32_t(*)[3]) malloc(sizeof(uint32_t[3]) * face_count) : NULL;
+
+    if(!remap || !keys || !orig_points || !rotated_points || !points || !edges ||
+        (obj->edge_flags && !edge_flags) || (face_count && (!faces || !face_edges))) {
+        free(remap);
+        free(keys);
+        free(orig_points);
+        free(rotated_points);
+        free(points);
+        free(edges);
+        free(edge_flags);
+        free(faces);
+        free(face_edges);
+
+        return false;
+    }
+
+    uint32_t* edge_remap = remap + point_count;
+    uint32_t next = 0;
+
+    for(uint32_t i = 0; i < point_count; i++)
+        remap[i] = GOBLIN3D_NO_EDGE;
+
+    for(uint32_t i = 0; i < edge_count; i++)
+        for(uint8_t j = 0; j < 2; j++)
+            if(remap[obj->edges[i][j]] == GOBLIN3D_NO_EDGE)
+                remap[obj->edges[i][j]] = next++;
+
+    for(uint32_t i = 0; i < point_count; i++) {
+        if(remap[i] == GOBLIN3D_NO_EDGE)
+            remap[i] = next++;
+
+        memcpy(orig_points[remap[i]], obj->orig_points[i], sizeof(float[3]));
+        memcpy(rotated_points[remap[i]], obj->rotated_points[i], sizeof(float[3]));
+        memcpy(points[remap[i]], obj->points[i], sizeof(float[2]));
+    }
+
+    for(uint32_t i = 0; i < edge_count; i++) {
+        uint64_t v1 = remap[obj->edges[i][0]], v2 = remap[obj->edges[i][1]];
+
+        keys[i].key = v1 < v2 ? (v1 << 32) | v2 : (v2 << 32) | v1;
+        keys[i].index = i;
+    }
+    qsort(keys, edge_count, sizeof(goblin3d_sort_key_t), goblin3d_compare_keys);
+
+    for(uint32_t i = 0; i < edge_count; i++) {
+        edges[i][0] = (uint32_t) (keys[i].key >> 32);
+        edges[i][1] = (uint32_t) keys[i].key;
+        edge_remap[keys[i].index] = i;
+
+        if(edge_flags)
+            edge_flags[i] = obj->edge_flags[keys[i].index];
+    }
+
+    for(uint32_t i = 0; i < face_count; i++) {
+        uint64_t lowest = GOBLIN3D_NO_EDGE;
+        for(uint8_t j = 0; j < 3; j++)
+            if(remap[obj->faces[i][j]] < lowest)
+                lowest = remap[obj->faces[i][j]];
+
+        keys[i].key = (lowest << 32) | i;
+        keys[i].index = i;
+    }
+    qsort(keys, face_count, sizeof(goblin3d_sort_key_t), goblin3d_compare_keys);
+
+    for(uint32_t i = 0; i < face_count; i++)
+        for(uint8_t j = 0; j < 3; j++) {
+            uint32_t face = keys[i].index;
+            uint32_t edge = obj->face_edges[face][j];
+
+            faces[i][j] = remap[obj->faces[face][j]];
+            face_edges[i][j] = edge == GOBLIN3D_NO_EDGE ? GOBLIN3D_NO_EDGE : edge_remap[edge];
+        }
+
+    if(obj->strip_count)
+        for(uint32_t i = 0; i < obj->strip_offsets[obj->strip_count]; i++)
+            obj->strip_indices[i] = remap[obj->strip_indices[i]];
+
+    for(uint8_t i = 0; i < obj->lod_count; i++) {
+        goblin3d_lod_t* lod = &obj->lods[i];
+
+        for(uint32_t j = 0; j < lod->edge_count; j++) {
+            lod->edges[j][0] = remap[lod->edges[j][0]];
+            lod->edges[j][1] = remap[lod->edges[j][1]];
+        }
+
+        for(uint32_t j = 0; j < lod->point_count; j++)
+            lod->point_indices[j] = remap[lod->point_indices[j]];
+        qsort(lod->point_indices, lod->point_count, sizeof(uint32_t), goblin3d_compare_indices);
+    }
+
+    free(obj->orig_points);
+    free(obj->rotated_points);
+    free(obj->points);
+    free(obj->edges);
+    free(obj->edge_flags);
+    free(obj->faces);
+    free(obj->face_edges);
+    free(obj->face_order);
+
+    obj->orig_points = orig_points;
+    obj->rotated_points = rotated_points;
+    obj->points = points;
+    obj->edges = edges;
+    obj->edge_flags = edge_flags;
+    obj->faces = faces;
+    obj->face_edges = face_edges;
+    obj->face_order = NULL;
+    goblin3d_free_edge_table(obj);
+
+    free(remap);
+    free(keys);
+
+    return true;
+}
+
+static inline uint32_t goblin3d_find_root(uint32_t* parent, uint32_t i) {
+    while(parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+
+    return i;
+}
+
+typedef struct {
+    double q[10];
+} goblin3d_quadric_t;
+
+typedef struct {
+    float cost;
+    uint32_t edge;
+    uint32_t version;
+} goblin3d_heap_item_t;
+
+typedef struct {
+    goblin3d_obj_t* obj;
+    uint32_t (*edges)[2];
+    uint32_t edge_count;
+    uint32_t live_count;
+
+    uint32_t* parent;
+    uint32_t* head;
+    uint32_t* next;
+    uint32_t* version;
+    uint32_t* stamp;
+    uint8_t* dead;
+
+    float (*positions)[3];
+    goblin3d_quadric_t* quadrics;
+
+    goblin3d_heap_item_t* heap;
+    uint32_t heap_size;
+    uint32_t heap_capacity;
+
+    uint32_t collapse_id;
+    bool move_points;
+} goblin3d_qem_t;
+
+static void goblin3d_quadric_add(goblin3d_quadric_t* quadric, const double* a, const double* b, double c,
+    double weight) {
+    quadric->q[0] += a[0] * weight; quadric->q[1] += a[1] * weight; quadric->q[2] += a[2] * weight;
+    quadric->q[3] += a[3] * weight; quadric->q[4] += a[4] * weight; quadric->q[5] += a[5] * weight;
+    quadric->q[6] += b[0] * weight; quadric->q[7] += b[1] * weight; quadric->q[8] += b[2] * weight;
+    quadric->q[9] += c * weight;
+}
+
+static double goblin3d_quadric_error(const goblin3d_quadric_t* quadric, const float* v) {
+    const double* q = quadric->q;
+    double x = v[0], y = v[1], z = v[2];
+
+    return q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z +
+        q[3] * y * y + 2.0 * q[4] * y * z + q[5] * z * z +
+        2.0 * (q[6] * x + q[7] * y + q[8] * z) + q[9];
+}
+
+static void goblin3d_qem_free(goblin3d_qem_t* qem) {
+    free(qem->edges);
+    free(qem->parent);
+    free(qem->head);
+    free(qem->next);
+    free(qem->version);
+    free(qem->stamp);
+    free(qem->dead);
+    free(qem->positions);
+    free(qem->quadrics);
+    free(qem->heap);
+}
+
+static float goblin3d_qem_evaluate(goblin3d_qem_t* qem, uint32_t edge, float* position, bool* keep_first) {
+    uint32_t v1 = goblin3d_find_root(qem->parent, qem->edges[edge][0]);
+    uint32_t v2 = goblin3d_find_root(qem->parent, qem->edges[edge][1]);
+
+    goblin3d_quadric_t sum;
+    for(uint8_t i = 0; i < 10; i++)
+        sum.q[i] = qem->quadrics[v1].q[i] + qem->quadrics[v2].q[i];
+
+    float* a = qem->positions[v1];
+    float* b = qem->positions[v2];
+    double error_a = goblin3d_quadric_error(&sum, a);
+    double error_b = goblin3d_quadric_error(&sum, b);
+
+    *keep_first = error_a <= error_b;
+    memcpy(position, *keep_first ? a : b, sizeof(float[3]));
+
+    double best = *keep_first ? error_a : error_b;
+    if(!qem->move_points)
+        return (float) best;
+
+    const double* q = sum.q;
+    double det = q[0] * (q[3] * q[5] - q[4] * q[4]) -
+        q[1] * (q[1] * q[5] - q[4] * q[2]) +
+        q[2] * (q[1] * q[4] - q[3] * q[2]);
+
+    float candidate[3];
+    if(fabs(det) > 1e-12) {
+        double inv = 1.0 / det;
+
+        candidate[0] = (float) (-inv * (q[6] * (q[3] * q[5] - q[4] * q[4]) -
+            q[1] * (q[7] * q[5] - q[4] * q[8]) + q[2] * (q[7] * q[4] - q[3] * q[8])));
+        candidate[1] = (float) (-inv * (q[0] * (q[7] * q[5] - q[8] * q[4]) -
+            q[6] * (q[1] * q[5] - q[4] * q[2]) + q[2] * (q[1] * q[8] - q[7] * q[2])));
+        candidate[2] = (float) (-inv * (q[0] * (q[3] * q[8] - q[4] * q[7]) -
+            q[1] * (q[1] * q[8] - q[7] * q[2]) + q[6] * (q[1] * q[4] - q[3] * q[2])));
+    }
+    else for(uint8_t i = 0; i < 3; i++)
+        candidate[i] = (a[i] + b[i]) * 0.5f;
+
+    double error = goblin3d_quadric_error(&sum, candidate);
+    if(error < best) {
+        best = error;
+        memcpy(position, candidate, sizeof(float[3]));
+    }
+
+    return (float) (best > 0.0 ? best : 0.0);
+}
+
+static bool goblin3d_qem_push(goblin3d_qem_t* qem, uint32_t edge) {
+    if(qem->heap_size == qem->heap_capacity) {
+        uint32_t capacity = qem->heap_capacity * 2 + 16;
+        goblin3d_heap_item_t* heap = (goblin3d_heap_item_t*) realloc(qem->heap,
+            sizeof(goblin3d_heap_item_t) * capacity);
+
+        if(!heap)
+            return false;
+
+        qem->heap = heap;
+        qem->heap_capacity = capacity;
+    }
+
+    float position[3];
+    bool keep_first;
+
+    goblin3d_heap_item_t item = {
+        goblin3d_qem_evaluate(qem, edge, position, &keep_first),
+        edge, ++qem->version[edge]
+    };
+
+    uint32_t i = qem->heap_size++;
+    while(i > 0 && qem->heap[(i - 1) / 2].cost > item.cost) {
+        qem->heap[i] = qem->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    qem->heap[i] = item;
+
+    return true;
+}
+
+static goblin3d_heap_item_t goblin3d_qem_pop(goblin3d_qem_t* qem) {
+    goblin3d_heap_item_t top = qem->heap[0];
+    goblin3d_heap_item_t last = qem->heap[--qem->heap_size];
+
+    uint32_t i = 0;
+    while(true) {
+        uint32_t child = i * 2 + 1;
+        if(child >= qem->heap_size)
+            break;
+
+        if(child + 1 < qem->heap_size && qem->heap[child + 1].cost < qem->heap[child].cost)
+            child++;
+
+        if(qem->heap[child].cost >= last.cost)
+            break;
+
+        qem->heap[i] = qem->heap[child];
+        i = child;
+    }
+
+    if(qem->heap_size > 0)
+        qem->heap[i] = last;
+    return top;
+}
+
+static bool goblin3d_qem_init(goblin3d_qem_t* qem, goblin3d_obj_t* obj, bool move_points) {
+    uint32_t point_count = obj->point_count, edge_count = obj->edge_count;
+
+    memset(qem, 0, sizeof(goblin3d_qem_t));
+    qem->obj = obj;
+    qem->edge_count = edge_count;
+    qem->live_count = edge_count;
+    qem->move_points = move_points;
+
+    qem->edges = (uint32_t(*)[2]) malloc(sizeof(uint32_t[2]) * (edge_count + 1));
+    qem->parent = (uint32_t*) malloc(sizeof(uint32_t) * (point_count + 1));
+    qem->head = (uint32_t*) malloc(sizeof(uint32_t) * (point_count + 1));
+    qem->next = (uint32_t*) malloc(sizeof(uint32_t) * (edge_count * 2 + 1));
+    qem->version = (uint32_t*) calloc(edge_count + 1, sizeof(uint32_t));
+    qem->stamp = (uint32_t*) calloc(point_count + 1, sizeof(uint32_t));
+    qem->dead = (uint8_t*) calloc(edge_count + 1, 1);
+    qem->positions = (float(*)[3]) malloc(sizeof(float[3]) * (point_count + 1));
+    qem->quadrics = (goblin3d_quadric_t*) calloc(point_count + 1, sizeof(goblin3d_quadric_t));
+
+    if(!qem->edges || !qem->parent || !qem->head || !qem->next || !qem->version ||
+        !qem->stamp || !qem->dead || !qem->positions || !qem->quadrics) {
+        goblin3d_qem_free(qem);
+        return false;
+    }
+
+    memcpy(qem->edges, obj->edges, sizeof(uint32_t[2]) * edge_count);
+    memcpy(qem->positions, obj->orig_points, sizeof(float[3]) * point_count);
+
+    for(uint32_t i = 0; i < point_count; i++) {
+        qem->parent[i] = i;
+        qem->head[i] = GOBLIN3D_NO_EDGE;
+    }
+
+    for(uint32_t i = 0; i < edge_count; i++)
+        for(uint8_t side = 0; side < 2; side++) {
+            uint32_t point = qem->edges[i][side];
+
+            qem->next[i * 2 + side] = qem->head[point];
+            qem->head[point] = i * 2 + side;
+        }
+
+    for(uint32_t i = 0; i < obj->face_count; i++) {
+        float* a = obj->orig_points[obj->faces[i][0]];
+        float* b = obj->orig_points[obj->faces[i][1]];
+        float* c = obj->orig_points[obj->faces[i][2]];
+
+        double ux = b[0] - a[0], uy = b[1] - a[1], uz = b[2] - a[2];
+        double vx = c[0] - a[0], vy = c[1] - a[1], vz = c[2] - a[2];
+        double n[3] = { uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx };
+
+        double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if(length == 0.0)
+            continue;
+
+        n[0] /= length; n[1] /= length; n[2] /= length;
+        double d = -(n[0] * a[0] + n[1] * a[1] + n[2] * a[2]);
+
+        double plane_a[6] = { n[0] * n[0], n[0] * n[1], n[0] * n[2], n[1] * n[1], n[1] * n[2], n[2] * n[2] };
+        double plane_b[3] = { d * n[0], d * n[1], d * n[2] };
+
+        for(uint8_t j = 0; j < 3; j++)
+            goblin3d_quadric_add(&qem->quadrics[obj->faces[i][j]], plane_a, plane_b, d * d, length * 0.5);
+    }
+
+    // Without faces, each edge contributes the squared distance to its
+    // supporting line, which keeps wireframe-only meshes in shape.
+    if(obj->face_count == 0)
+        for(uint32_t i = 0; i < edge_count; i++) {
+            float* p = obj->orig_points[qem->edges[i][0]];
+            float* e = obj->orig_points[qem->edges[i][1]];
+
+            double d[3] = { e[0] - p[0], e[1] - p[1], e[2] - p[2] };
+            double length = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+            if(length == 0.0)
+                continue;
+
+            d[0] /= length; d[1] /= length; d[2] /= length;
+            double line_a[6] = {
+                1.0 - d[0] * d[0], -d[0] * d[1], -d[0] * d[2],
+                1.0 - d[1] * d[1], -d[1] * d[2], 1.0 - d[2] * d[2]
+            };
+            double line_b[3] = {
+                -(line_a[0] * p[0] + line_a[1] * p[1] + line_a[2] * p[2]),
+                -(line_a[1] * p[0] + line_a[3] * p[1] + line_a[4] * p[2]),
+                -(line_a[2] * p[0] + line_a[4] * p[1] + line_a[5] * p[2])
+            };
+            double line_c = -(line_b[0] * p[0] + line_b[1] * p[1] + line_b[2] * p[2]);
+
+            goblin3d_quadric_add(&qem->quadrics[qem->edges[i][0]], line_a, line_b, line_c, length);
+            goblin3d_quadric_add(&qem->quadrics[qem->edges[i][1]], line_a, line_b, line_c, length);
+        }
+
+    for(uint32_t i = 0; i < edge_count; i++)
+        if(!goblin3d_qem_push(qem, i)) {
+            goblin3d_qem_free(qem);
+            return false;
+        }
+
+    return true;
+}
+
+static inline void goblin3d_qem_kill(goblin3d_qem_t* qem, uint32_t edge) {
+    if(!qem->dead[edge]) {
+        qem->dead[edge] = 1;
+        qem->live_count--;
+    }
+}
+
+static bool goblin3d_qem_collapse(goblin3d_qem_t* qem, uint32_t edge) {
+    float position[3];
+    bool keep_first;
+    goblin3d_qem_evaluate(qem, edge, position, &keep_first);
+
+    uint32_t v1 = goblin3d_find_root(qem->parent, qem->edges[edge][0]);
+    uint32_t v2 = goblin3d_find_root(qem->parent, qem->edges[edge][1]);
+    uint32_t kept = keep_first ? v1 : v2, removed = keep_first ? v2 : v1;
+    uint32_t id = ++qem->collapse_id;
+
+    for(uint32_t slot = qem->head[kept]; slot != GOBLIN3D_NO_EDGE; slot = qem->next[slot]) {
+        uint32_t other = goblin3d_find_root(qem->parent, qem->edges[slot / 2][1 - slot % 2]);
+        if(!qem->dead[slot / 2] && other != removed)
+            qem->stamp[other] = id;
+    }
+
+    uint32_t tail = GOBLIN3D_NO_EDGE;
+    for(uint32_t slot = qem->head[removed]; slot != GOBLIN3D_NO_EDGE; slot = qem->next[slot]) {
+        uint32_t other = goblin3d_find_root(qem->parent, qem->edges[slot / 2][1 - slot % 2]);
+
+        if(!qem->dead[slot / 2]) {
+            if(other == kept || qem->stamp[other] == id)
+                goblin3d_qem_kill(qem, slot / 2);
+            else qem->stamp[other] = id;
+        }
+
+        tail = slot;
+    }
+
+    if(tail != GOBLIN3D_NO_EDGE) {
+        qem->next[tail] = qem->head[kept];
+        qem->head[kept] = qem->head[removed];
+    }
+
+    qem->head[removed] = GOBLIN3D_NO_EDGE;
+    qem->parent[removed] = kept;
+    memcpy(qem->positions[kept], position, sizeof(float[3]));
+
+    for(uint8_t i = 0; i < 10; i++)
+        qem->quadrics[kept].q[i] += qem->quadrics[removed].q[i];
+
+    uint32_t* link = &qem->head[kept];
+    while(*link != GOBLIN3D_NO_EDGE) {
+        uint32_t slot = *link;
+        if(qem->dead[slot / 2]) {
+            *link = qem->next[slot];
+            continue;
+        }
+
+        if(!goblin3d_qem_push(qem, slot / 2))
+            return false;
+        link = &qem->next[slot];
+    }
+
+    return true;
+}
+
+static bool goblin3d_qem_reduce(goblin3d_qem_t* qem, uint32_t target) {
+    while(qem->live_count > target && qem->heap_size > 0) {
+        goblin3d_heap_item_t item = goblin3d_qem_pop(qem);
+        if(qem->dead[item.edge] || item.version != qem->version[item.edge])
+            continue;
+
+        if(!goblin3d_qem_collapse(qem, item.edge))
+            return false;
+    }
+
+    return true;
+}
+
+static uint32_t goblin3d_qem_edges(goblin3d_qem_t* qem, uint32_t (*edges)[2], const uint32_t* remap) {
+    uint32_t count = 0;
+
+    for(uint32_t i = 0; i < qem->edge_count; i++) {
+        if(qem->dead[i])
+            continue;
+
+        uint32_t v1 = goblin3d_find_root(qem->parent, qem->edges[i][0]);
+        uint32_t v2 = goblin3d_find_root(qem->parent, qem->edges[i][1]);
+        if(remap) {
+            v1 = remap[v1];
+            v2 = remap[v2];
+        }
+
+        edges[count][0] = v1 < v2 ? v1 : v2;
+        edges[count++][1] = v1 < v2 ? v2 : v1;
+    }
+
+    return count;
+}
+
+bool goblin3d_build_lods(goblin3d_obj_t* obj, uint8_t levels, float pixel_radius) {
+    goblin3d_free_lods(obj);
+    goblin3d_update_bounds(obj);
+
+    if(levels == 0 || obj->edge_count == 0)
+        return true;
+
+    goblin3d_qem_t qem;
+    uint8_t* used = (uint8_t*) malloc(obj->point_count + 1);
+
+    obj->lods = (goblin3d_lod_t*) calloc(levels, sizeof(goblin3d_lod_t));
+    if(!used || !obj->lods || !goblin3d_qem_init(&qem, obj, false)) {
+        free(used);
+        goblin3d_free_lods(obj);
+
+        return false;
+    }
+
+    bool success = true;
+    for(uint8_t level = 0; level < levels; level++) {
+        uint32_t previous = qem.live_count;
+        if(!goblin3d_qem_reduce(&qem, previous / 2)) {
+            success = false;
+            break;
+        }
+
+        if(qem.live_count == 0 || qem.live_count == previous)
+            break;
+
+        goblin3d_lod_t* lod = &obj->lods[level];
+        lod->edge_count = qem.live_count;
+        lod->max_radius = pixel_radius / (float) (1 << level);
+        lod->edges = (uint32_t(*)[2]) malloc(sizeof(uint32_t[2]) * lod->edge_count);
+
+        obj->lod_count++;
+        if(!lod->edges) {
+            success = false;
+            break;
+        }
+        goblin3d_qem_edges(&qem, lod->edges, NULL);
+
+        memset(used, 0, obj->point_count);
+        for(uint32_t i = 0; i < lod->edge_count; i++)
+            used[lod->edges[i][0]] = used[lod->edges[i][1]] = 1;
+
+        for(uint32_t i = 0; i < obj->point_count; i++)
+            lod->point_count += used[i];
+
+        lod->point_indices = (uint32_t*) malloc(sizeof(uint32_t) * (lod->point_count + 1));
+        if(!lod->point_indices) {
+            success = false;
+            break;
+        }
+
+        for(uint32_t i = 0, j = 0; i < obj->point_count; i++)
+            if(used[i])
+                lod->point_indices[j++] = i;
+    }
+
+    free(used);
+    goblin3d_qem_free(&qem);
+
+    if(!success)
+        goblin3d_free_lods(obj);
+    return success;
+}
+
+static uint32_t goblin3d_search_edge(uint32_t (*edges)[2], uint32_t count, uint32_t v1, uint32_t v2) {
+    uint64_t key = v1 < v2 ? ((uint64_t) v1 << 32) | v2 : ((uint64_t) v2 << 32) | v1;
+    uint32_t lo = 0, hi = count;
+
+    while(lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint64_t mid_key = ((uint64_t) edges[mid][0] << 32) | edges[mid][1];
+
+        if(mid_key == key)
+            return mid;
+        else if(mid_key < key)
+            lo = mid + 1;
+        else hi = mid;
+    }
+
+    return GOBLIN3D_NO_EDGE;
+}
+
+bool goblin3d_simplify(goblin3d_obj_t* obj, uint32_t target_edges) {
+    if(obj->borrowed && !goblin3d_own(obj))
+        return false;
+
+    if(obj->edge_count <= target_edges)
+        return true;
+
+    goblin3d_qem_t qem;
+    if(!goblin3d_qem_init(&qem, obj, true))
+        return false;
+
+    if(!goblin3d_qem_reduce(&qem, target_edges)) {
+        goblin3d_qem_free(&qem);
+        return false;
+    }
+
+    uint32_t* remap = (uint32_t*) malloc(sizeof(uint32_t) * (obj->point_count + 1));
+    goblin3d_sort_key_t* keys = (goblin3d_sort_key_t*) malloc(sizeof(goblin3d_sort_key_t) * (qem.live_count + 1));
+    uint32_t (*edges)[2] = (uint32_t(*)[2]) malloc(sizeof(uint32_t[2]) * (qem.live_count + 1));
+
+    uint32_t point_count = 0;
+    for(uint32_t i = 0; remap && i < obj->point_count; i++)
+        if(goblin3d_find_root(qem.parent, i) == i)
+            remap[i] = point_count++;
+
+    float (*orig_points)[3] = (float(*)[3]) malloc(sizeof(float[3]) * (point_count + 1));
+    float (*rotated_points)[3] = (float(*)[3]) calloc(point_count + 1, sizeof(float[3]));
+    float (*points)[2] = (float(*)[2]) calloc(point_count + 1, sizeof(float[2]));
+
+    if(!remap || !keys || !edges || !orig_points || !rotated_points || !points) {
+        free(remap);
+        free(keys);
+        free(edges);
+        free(orig_points);
+        free(rotated_points);
+        free(points);
+        goblin3d_qem_free(&qem);
+
+        return false;
+    }
+
+    for(uint32_t i = 0; i < obj->point_count; i++)
+        if(goblin3d_find_root(qem.parent, i) == i)
+            memcpy(orig_points[remap[i]], qem.positions[i], sizeof(float[3]));
+
+    for(uint32_t i = 0; i < obj->point_count; i++)
+        remap[i] = remap[goblin3d_find_root(qem.parent, i)];
+
+    uint32_t edge_count = goblin3d_qem_edges(&qem, edges, remap);
+    for(uint32_t i = 0; i < edge_count; i++) {
+        keys[i].key = ((uint64_t) edges[i][0] << 32) | edges[i][1];
+        keys[i].index = i;
+    }
+    qsort(keys, edge_count, sizeof(goblin3d_sort_key_t), goblin3d_compare_keys);
+
+    for(uint32_t i = 0; i < edge_count; i++) {
+        edges[i][0] = (uint32_t) (keys[i].key >> 32);
+        edges[i][1] = (uint32_t) keys[i].key;
+    }
+
+    uint32_t face_count = 0;
+    for(uint32_t i = 0; i < obj->face_count; i++) {
+        uint32_t a = remap[obj->faces[i][0]], b = remap[obj->faces[i][1]], c = remap[obj->faces[i][2]];
+        if(a == b || b == c || c == a)
+            continue;
+
+        obj->faces[face_count][0] = a;
+        obj->faces[face_count][1] = b;
+        obj->faces[face_count++][2] = c;
+    }
+
+    if(obj->edge_flags) {
+        uint8_t* edge_flags = (uint8_t*) realloc(obj->edge_flags, edge_count + 1);
+        if(edge_flags)
+            obj->edge_flags = edge_flags;
+        memset(obj->edge_flags, 0, edge_count);
+
+        for(uint32_t i = 0; i < face_count; i++)
+            for(uint8_t j = 0; j < 3; j++) {
+                uint32_t edge = goblin3d_search_edge(edges, edge_count,
+                    obj->faces[i][j], obj->faces[i][(j + 1) % 3]);
+
+                obj->face_edges[i][j] = edge;
+                if(edge != GOBLIN3D_NO_EDGE)
+                    obj->edge_flags[edge] |= GOBLIN3D_EDGE_HAS_FACE;
+            }
+    }
+
+    free(obj->orig_points);
+    free(obj->rotated_points);
+    free(obj->points);
+    free(obj->edges);
+
+    obj->orig_points = orig_points;
+    obj->rotated_points = rotated_points;
+    obj->points = points;
+    obj->edges = edges;
+    obj->point_count = point_count;
+    obj->edge_count = edge_count;
+    obj->face_count = face_count;
+
+    if(obj->face_order)
+        free(obj->face_order);
+    obj->face_order = NULL;
+
+    goblin3d_free_strips(obj);
+    goblin3d_free_lods(obj);
+    goblin3d_free_edge_table(obj);
+    goblin3d_update_bounds(obj);
+
+    free(remap);
+    free(keys);
+    goblin3d_qem_free(&qem);
+
+    return true;
+}
+
+static inline uint32_t goblin3d_point_hash(const float* point, uint8_t bits) {
+    uint32_t words[3];
+    memcpy(words, point, sizeof(words));
+
+    uint64_t key = (words[0] * 0x9E3779B97F4A7C15ull) ^ (words[1] * 0xC2B2AE3D27D4EB4Full) ^
+        (words[2] * 0x165667B19E3779F9ull);
+    return (uint32_t) ((key * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+static inline int64_t goblin3d_weld_cell(float value, float inverse, int8_t* side) {
+    double scaled = (double) value * inverse, cell = floor(scaled);
+
+    *side = scaled - cell < 0.5 ? -1 : 1;
+    return (int64_t) (cell < -1e15 ? -1e15 : (cell > 1e15 ? 1e15 : cell));
+}
+
+static inline uint32_t goblin3d_cell_hash(int64_t x, int64_t y, int64_t z, uint8_t bits) {
+    uint64_t key = ((uint64_t) x * 0x9E3779B97F4A7C15ull) ^ ((uint64_t) y * 0xC2B2AE3D27D4EB4Full) ^
+        ((uint64_t) z * 0x165667B19E3779F9ull);
+    return (uint32_t) ((key * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+static uint32_t goblin3d_weld_point(goblin3d_obj_t* obj, uint32_t* table, uint8_t bits,
+    const float* point, float epsilon, uint32_t welded) {
+    uint32_t mask = ((uint32_t) 1 << bits) - 1, slot;
+
+    if(epsilon <= 0.0f) {
+        for(slot = goblin3d_point_hash(point, bits); table[slot] != GOBLIN3D_NO_EDGE; slot = (slot + 1) & mask) {
+            const float* existing = obj->orig_points[table[slot]];
+
+            if(existing[0] == point[0] && existing[1] == point[1] && existing[2] == point[2])
+                return table[slot];
+        }
+
+        table[slot] = welded;
+        return welded;
+    }
+
+    float inverse = 0.5f / epsilon, limit = epsilon * epsilon;
+    int64_t cell[3];
+    int8_t side[3];
+
+    for(uint8_t i = 0; i < 3; i++)
+        cell[i] = goblin3d_weld_cell(point[i], inverse, &side[i]);
+
+    for(uint8_t neighbor = 0; neighbor < 8; neighbor++)
+        for(slot = goblin3d_cell_hash(cell[0] + ((neighbor & 1) ? side[0] : 0),
+            cell[1] + ((neighbor & 2) ? side[1] : 0), cell[2] + ((neighbor & 4) ? side[2] : 0), bits);
+            table[slot] != GOBLIN3D_NO_EDGE; slot = (slot + 1) & mask) {
+            const float* existing = obj->orig_points[table[slot]];
+            float x = existing[0] - point[0], y = existing[1] - point[1], z = existing[2] - point[2];
+
+            if(x * x + y * y + z * z <= limit)
+                return table[slot];
+        }
+
+    for(slot = goblin3d_cell_hash(cell[0], cell[1], cell[2], bits); table[slot] != GOBLIN3D_NO_EDGE;)
+        slot = (slot + 1) & mask;
+
+    table[slot] = welded;
+    return welded;
+}
+
+bool goblin3d_weld(goblin3d_obj_t* obj, float epsilon) {
+    if(obj->borrowed && !goblin3d_own(obj))
+        return false;
+
+    uint32_t point_count = obj->point_count, edge_count = obj->edge_count;
+    uint8_t point_bits = 4, edge_bits = 4;
+
+    while(((uint64_t) 1 << point_bits) < (uint64_t) point_count * 2)
+        point_bits++;
+
+    while(((uint64_t) 1 << edge_bits) < (uint64_t) edge_count * 2)
+        edge_bits++;
+
+    uint32_t* remap = (uint32_t*) malloc(sizeof(uint32_t) * ((size_t) point_count + edge_count + 1));
+    uint32_t* point_table = (uint32_t*) malloc(sizeof(uint32_t) << point_bits);
+    uint32_t* edge_table = (uint32_t*) malloc(sizeof(uint32_t) << edge_bits);
+
+    if(!remap || !point_table || !edge_table) {
+        free(remap);
+        free(point_table);
+        free(edge_table);
+
+        return false;
+    }
+
+    memset(point_table, 0xFF, sizeof(uint32_t) << point_bits);
+    memset(edge_table, 0xFF, sizeof(uint32_t) << edge_bits);
+
+    uint32_t welded = 0;
+    for(uint32_t i = 0; i < point_count; i++) {
+        float point[3] = {
+            obj->orig_points[i][0] + 0.0f,
+            obj->orig_points[i][1] + 0.0f,
+            obj->orig_points[i][2] + 0.0f
+        };
+
+        remap[i] = goblin3d_weld_point(obj, point_table, point_bits, point, epsilon, welded);
+        if(remap[i] == welded)
+            memcpy(obj->orig_points[welded++], point, sizeof(float[3]));
+    }
+
+    uint32_t* edge_remap = remap + point_count;
+    uint32_t kept = 0, mask = ((uint32_t) 1 << edge_bits) - 1;
+
+    for(uint32_t i = 0; i < edge_count; i++) {
+        uint32_t v1 = remap[obj->edges[i][0]], v2 = remap[obj->edges[i][1]], slot;
+
+        edge_remap[i] = GOBLIN3D_NO_EDGE;
+        if(v1 == v2)
+            continue;
+
+        for(slot = goblin3d_edge_hash(v1, v2, edge_bits); edge_table[slot] != GOBLIN3D_NO_EDGE; slot = (slot + 1) & mask) {
+            uint32_t* existing = obj->edges[edge_table[slot]];
+
+            if((existing[0] == v1 && existing[1] == v2) || (existing[0] == v2 && existing[1] == v1)) {
+                edge_remap[i] = edge_table[slot];
+                break;
+            }
+        }
+
+        if(edge_remap[i] != GOBLIN3D_NO_EDGE)
+            continue;
+
+        obj->edges[kept][0] = v1;
+        obj->edges[kept][1] = v2;
+
+        if(obj->edge_flags)
+            obj->edge_flags[kept] = 0;
+
+        edge_table[slot] = kept;
+        edge_remap[i] = kept++;
+    }
+
+    uint32_t face_count = 0;
+    for(uint32_t i = 0; i < obj->face_count; i++) {
+        uint32_t a = remap[obj->faces[i][0]], b = remap[obj->faces[i][1]], c = remap[obj->faces[i][2]];
+        if(a == b || b == c || c == a)
+            continue;
+
+        obj->faces[face_count][0] = a;
+        obj->faces[face_count][1] = b;
+        obj->faces[face_count][2] = c;
+
+        for(uint8_t j = 0; j < 3; j++) {
+            uint32_t edge = obj->face_edges[i][j];
+
+            edge = edge == GOBLIN3D_NO_EDGE ? GOBLIN3D_NO_EDGE : edge_remap[edge];
+            obj->face_edges[face_count][j] = edge;
+
+            if(edge != GOBLIN3D_NO_EDGE && obj->edge_flags)
+                obj->edge_flags[edge] |= GOBLIN3D_EDGE_HAS_FACE;
+        }
+
+        face_count++;
+    }
+
+    free(remap);
+    free(point_table);
+    free(edge_table);
+
+    obj->point_count = welded;
+    obj->edge_count = kept;
+    obj->face_count = face_count;
+
+    float (*orig_points)[3] = (float(*)[3]) realloc(obj->orig_points, sizeof(float[3]) * (welded + 1));
+    if(orig_points)
+        obj->orig_points = orig_points;
+
+    float (*rotated_points)[3] = (float(*)[3]) realloc(obj->rotated_points, sizeof(float[3]) * (welded + 1));
+    if(rotated_points)
+        obj->rotated_points = rotated_points;
+
+    float (*points)[2] = (float(*)[2]) realloc(obj->points, sizeof(float[2]) * (welded + 1));
+    if(points)
+        obj->points = points;
+
+    uint32_t (*edges)[2] = (uint32_t(*)[2]) realloc(obj->edges, sizeof(uint32_t[2]) * (kept + 1));
+    if(edges)
+        obj->edges = edges;
+
+    if(obj->face_order)
+        free(obj->face_order);
+    obj->face_order = NULL;
+
+    goblin3d_free_strips(obj);
+    goblin3d_free_lods(obj);
+    goblin3d_free_edge_table(obj);
+    goblin3d_update_bounds(obj);
+
+    return true;
+}
+
+typedef struct {
+    goblin3d_obj_t* obj;
+    uint8_t flags;
+    bool counting;
+
+    uint32_t point_capacity;
+    uint32_t edge_capacity;
+    uint32_t face_capacity;
+
+    uint32_t* edge_table;
+    uint8_t edge_table_bits;
+
+    uint64_t* edge_keys;
+    uint8_t edge_key_bits;
+
+    uint32_t* indices;
+    uint32_t index_capacity;
+
+    char* tail;
+    size_t tail_length;
+    size_t tail_capacity;
+} goblin3d_obj_parser_t;
+
+static const double goblin3d_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline const char* goblin3d_skip_spaces(const char* cursor, const char* end) {
+    while(cursor < end && (*cursor == ' ' || *cursor == '\t'))
+        cursor++;
+
+    return cursor;
+}
+
+static const char* goblin3d_parse_float(const char* cursor, const char* end, float* value) {
+    cursor = goblin3d_skip_spaces(cursor, end);
+
+    bool negative = false;
+    if(cursor < end && (*cursor == '-' || *cursor == '+'))
+        negative = *cursor++ == '-';
+
+    uint64_t mantissa = 0;
+    int32_t exponent = 0, digits = 0, significant = 0;
+
+    for(; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++, digits++) {
+        if(significant < 19) {
+            mantissa = mantissa * 10 + (*cursor - '0');
+            significant += mantissa > 0;
+        }
+        else exponent++;
+    }
+
+    if(cursor < end && *cursor == '.')
+        for(cursor++; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++, digits++)
+            if(significant < 19) {
+                mantissa = mantissa * 10 + (*cursor - '0');
+                significant += mantissa > 0;
+                exponent--;
+            }
+
+    if(digits == 0)
+        return NULL;
+
+    if(cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        const char* start = cursor++;
+        bool negative_exponent = false;
+
+        if(cursor < end && (*cursor == '-' || *cursor == '+'))
+            negative_exponent = *cursor++ == '-';
+
+        if(cursor < end && *cursor >= '0' && *cursor <= '9') {
+            int32_t written = 0;
+            for(; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++)
+                if(written < 10000)
+                    written = written * 10 + (*cursor - '0');
+
+            exponent += negative_exponent ? -written : written;
+        }
+        else cursor = start;
+    }
+
+    double result = (double) mantissa;
+    while(exponent > 22 && result != 0.0) {
+        result *= 1e22;
+        exponent -= 22;
+    }
+
+    while(exponent < -22 && result != 0.0) {
+        result /= 1e22;
+        exponent += 22;
+    }
+
+    if(exponent >= 0)
+        result *= goblin3d_powers_of_ten[exponent > 22 ? 22 : exponent];
+    else result /= goblin3d_powers_of_ten[-exponent > 22 ? 22 : -exponent];
+
+    *value = (float) (negative ? -result : result);
+    return cursor;
+}
+
+static const char* goblin3d_parse_index(const char* cursor, const char* end, int64_t* value) {
+    cursor = goblin3d_skip_spaces(cursor, end);
+
+    bool negative = false;
+    if(cursor < end && (*cursor == '-' || *cursor == '+'))
+        negative = *cursor++ == '-';
+
+    if(cursor == end || *cursor < '0' || *cursor > '9')
+        return NULL;
+
+    int64_t result = 0;
+    for(; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++)
+        if(result < 0x100000000ll)
+            result = result * 10 + (*cursor - '0');
+
+    while(cursor < end && *cursor != ' ' && *cursor != '\t')
+        cursor++;
+
+    *value = negative ? -result : result;
+    return cursor;
+}
+
+static void goblin3d_parser_init(goblin3d_obj_parser_t* parser, goblin3d_obj_t* obj, uint8_t flags) {
+    memset(parser, 0, sizeof(goblin3d_obj_parser_t));
+
+    parser->obj = obj;
+    parser->flags = flags;
+    parser->counting = (flags & GOBLIN3D_PARSE_EXACT) != 0;
+    goblin3d_init_empty(obj);
+}
+
+static void goblin3d_parser_free(goblin3d_obj_parser_t* parser) {
+    free(parser->edge_table);
+    free(parser->edge_keys);
+    free(parser->indices);
+    free(parser->tail);
+
+    parser->edge_table = NULL;
+    parser->edge_keys = NULL;
+    parser->indices = NULL;
+    parser->tail = NULL;
+}
+
+static bool goblin3d_parser_rehash(goblin3d_obj_parser_t* parser, uint8_t bits) {
+    goblin3d_obj_t* obj = parser->obj;
+
+    uint32_t* table = goblin3d_hash_edges(obj->edges, obj->edge_count, bits);
+    if(!table)
+        return false;
+
+    free(parser->edge_table);
+    parser->edge_table = table;
+    parser->edge_table_bits = bits;
+
+    return true;
+}
+
+static bool goblin3d_parser_count_edge(goblin3d_obj_parser_t* parser, uint32_t v1, uint32_t v2) {
+    goblin3d_obj_t* obj = parser->obj;
+
+    if(!parser->edge_keys || (uint64_t) obj->edge_count * 2 >= ((uint64_t) 1 << parser->edge_key_bits)) {
+        uint8_t bits = parser->edge_keys ? parser->edge_key_bits + 1 : 10;
+        uint32_t size = (uint32_t) 1 << bits;
+
+        uint64_t* keys = (uint64_t*) calloc(size, sizeof(uint64_t));
+        if(!keys)
+            return false;
+
+        for(uint32_t i = 0; parser->edge_keys && i < ((uint32_t) 1 << parser->edge_key_bits); i++) {
+            uint64_t key = parser->edge_keys[i];
+            if(key == 0)
+                continue;
+
+            uint32_t slot = goblin3d_edge_hash((uint32_t) (key >> 32), (uint32_t) key, bits);
+            while(keys[slot] != 0)
+                slot = (slot + 1) & (size - 1);
+            keys[slot] = key;
+        }
+
+        free(parser->edge_keys);
+        parser->edge_keys = keys;
+        parser->edge_key_bits = bits;
+    }
+
+    uint64_t key = v1 < v2 ? ((uint64_t) v1 << 32) | v2 : ((uint64_t) v2 << 32) | v1;
+    uint32_t mask = ((uint32_t) 1 << parser->edge_key_bits) - 1;
+    uint32_t slot = goblin3d_edge_hash(v1, v2, parser->edge_key_bits);
+
+    for(; parser->edge_keys[slot] != 0; slot = (slot + 1) & mask)
+        if(parser->edge_keys[slot] == key)
+            return true;
+
+    parser->edge_keys[slot] = key;
+    obj->edge_count++;
+
+    return true;
+}
+
+static bool goblin3d_parser_edge(goblin3d_obj_parser_t* parser, uint32_t v1, uint32_t v2, uint32_t* edge) {
+    goblin3d_obj_t* obj = parser->obj;
+
+    *edge = GOBLIN3D_NO_EDGE;
+    if(v1 == v2)
+        return true;
+
+    if(parser->counting)
+        return goblin3d_parser_count_edge(parser, v1, v2);
+
+    if(!parser->edge_table || (uint64_t) obj->edge_count * 2 >= ((uint64_t) 1 << parser->edge_table_bits))
+        if(!goblin3d_parser_rehash(parser, parser->edge_table ? parser->edge_table_bits + 1 : 10))
+            return false;
+
+    uint32_t mask = ((uint32_t) 1 << parser->edge_table_bits) - 1;
+    uint32_t slot = goblin3d_edge_hash(v1, v2, parser->edge_table_bits);
+
+    for(; parser->edge_table[slot] != GOBLIN3D_NO_EDGE; slot = (slot + 1) & mask) {
+        uint32_t* existing = obj->edges[parser->edge_table[slot]];
+
+        if((existing[0] == v1 && existing[1] == v2) ||
+            (existing[0] == v2 && existing[1] == v1)) {
+            *edge = parser->edge_table[slot];
+            return true;
+        }
+    }
+
+    if(obj->edge_count == parser->edge_capacity) {
+        uint32_t capacity = parser->edge_capacity * 2 + 64;
+
+        uint32_t (*edges)[2] = (uint32_t(*)[2]) realloc(obj->edges, sizeof(uint32_t[2]) * capacity);
+        if(!edges)
+            return false;
+        obj->edges = edges;
+
+        if(parser->flags & GOBLIN3D_PARSE_KEEP_FACES) {
+            uint8_t* edge_flags = (uint8_t*) realloc(obj->edge_flags, capacity);
+            if(!edge_flags)
+                return false;
+            obj->edge_flags = edge_flags;
+        }
+
+        parser->edge_capacity = capacity;
+    }
+
+    *edge = obj->edge_count++;
+    obj->edges[*edge][0] = v1;
+    obj->edges[*edge][1] = v2;
+
+    if(obj->edge_flags)
+        obj->edge_flags[*edge] = 0;
+
+    parser->edge_table[slot] = *edge;
+    return true;
+}
+
+static bool goblin3d_parser_point(goblin3d_obj_parser_t* parser, float x, float y, float z) {
+    goblin3d_obj_t* obj = parser->obj;
+
+    if(parser->counting) {
+        obj->point_count++;
+        return true;
+    }
+
+    if(obj->point_count == parser->point_capacity) {
+        uint32_t capacity = parser->point_capacity * 2 + 64;
+
+        float (*orig_points)[3] = (float(*)[3]) realloc(obj->orig_points, sizeof(float[3]) * capacity);
+        if(!orig_points)
+            return false;
+
+        obj->orig_points = orig_points;
+        parser->point_capacity = capacity;
+    }
+
+    obj->orig_points[obj->point_count][0] = x;
+    obj->orig_points[obj->point_count][1] = y;
+    obj->orig_points[obj->point_count++][2] = z;
+
+    return true;
+}
+
+static bool goblin3d_parser_face(goblin3d_obj_parser_t* parser, uint32_t a, uint32_t b, uint32_t c,
+    uint32_t ab, uint32_t bc, uint32_t ca) {
+    goblin3d_obj_t* obj = parser->obj;
+
+    if(parser->counting) {
+        obj->face_count++;
+        return true;
+    }
+
+    if(obj->face_count == parser->face_capacity) {
+        uint32_t capacity = parser->face_capacity * 2 + 64;
+
+        uint32_t (*faces)[3] = (uint32_t(*)[3]) realloc(obj->faces, sizeof(uint32_t[3]) * capacity);
+        if(!faces)
+            return false;
+        obj->faces = faces;
+
+        uint32_t (*face_edges)[3] = (uint32_t(*)[3]) realloc(obj->face_edges, sizeof(uint32_t[3]) * capacity);
+        if(!face_edges)
+            return false;
+        obj->face_edges = face_edges;
+
+        parser->face_capacity = capacity;
+    }
+
+    uint32_t face = obj->face_count++;
+    obj->faces[face][0] = a;
+    obj->faces[face][1] = b;
+    obj->faces[face][2] = c;
+
+    obj->face_edges[face][0] = ab;
+    obj->face_edges[face][1] = bc;
+    obj->face_edges[face][2] = ca;
+
+    for(uint8_t i = 0; i < 3; i++)
+        if(obj->face_edges[face][i] != GOBLIN3D_NO_EDGE)
+            obj->edge_flags[obj->face_edges[face][i]] |= GOBLIN3D_EDGE_HAS_FACE;
+
+    return true;
+}
+
+static bool goblin3d_parser_polygon(goblin3d_obj_parser_t* parser, uint32_t count, bool closed) {
+    uint32_t* indices = parser->indices;
+    uint32_t sides = closed ? count : count - 1;
+
+    if(!closed || count < 3 || !(parser->flags & GOBLIN3D_PARSE_KEEP_FACES)) {
+        uint32_t edge;
+
+        for(uint32_t i = 0; i < sides; i++)
+            if(!goblin3d_parser_edge(parser, indices[i], indices[(i + 1) % count], &edge))
+                return false;
+
+        return true;
+    }
+
+    uint32_t first, side, closing = GOBLIN3D_NO_EDGE;
+    if(!goblin3d_parser_edge(parser, indices[0], indices[1], &first))
+        return false;
+
+    bool degenerate = false;
+    for(uint32_t i = 1; i < count - 1; i++) {
+        if(!goblin3d_parser_edge(parser, indices[i], indices[i + 1], &side))
+            return false;
+
+        if(i == count - 2 && !goblin3d_parser_edge(parser, indices[i + 1], indices[0], &closing))
+            return false;
+
+        if(indices[0] == indices[i] || indices[i] == indices[i + 1] || indices[i + 1] == indices[0]) {
+            degenerate = true;
+            continue;
+        }
+
+        if(!goblin3d_parser_face(parser, indices[0], indices[i], indices[i + 1],
+            i == 1 ? first : GOBLIN3D_NO_EDGE, side, i == count - 2 ? closing : GOBLIN3D_NO_EDGE))
+            return false;
+    }
+
+    if(degenerate && !parser->counting)
+        parser->obj->dropped_count++;
+
+    return true;
+}
+
+static bool goblin3d_parser_line(goblin3d_obj_parser_t* parser, const char* cursor, const char* end) {
+    cursor = goblin3d_skip_spaces(cursor, end);
+    if(end - cursor < 2 || (cursor[1] != ' ' && cursor[1] != '\t'))
+        return true;
+
+    char type = *cursor;
+    cursor += 2;
+
+    if(type == 'v') {
+        float x, y, z;
+
+        if(!(cursor = goblin3d_parse_float(cursor, end, &x)) ||
+            !(cursor = goblin3d_parse_float(cursor, end, &y)) ||
+            !(cursor = goblin3d_parse_float(cursor, end, &z)))
+            return true;
+
+        return goblin3d_parser_point(parser, x, y, z);
+    }
+
+    if(type != 'f' && type != 'l')
+        return true;
+
+    uint32_t count = 0;
+    int64_t index;
+
+    while((cursor = goblin3d_parse_index(cursor, end, &index)) != NULL) {
+        if(index < 0)
+            index += parser->obj->point_count;
+        else index--;
+
+        if(index < 0 || index >= parser->obj->point_count) {
+            if(!parser->counting)
+                parser->obj->dropped_count++;
+            return true;
+        }
+
+        if(count == parser->index_capacity) {
+            uint32_t capacity = parser->index_capacity * 2 + 16;
+
+            uint32_t* indices = (uint32_t*) realloc(parser->indices, sizeof(uint32_t) * capacity);
+            if(!indices)
+                return false;
+
+            parser->indices = indices;
+            parser->index_capacity = capacity;
+        }
+
+        parser->indices[count++] = (uint32_t) index;
+    }
+
+    if(count < 2)
+        return true;
+    return goblin3d_parser_polygon(parser, count, type == 'f');
+}
+
+static bool goblin3d_parser_feed(goblin3d_obj_parser_t* parser, const char* data, size_t length) {
+    const char* end = data + length;
+
+    if(parser->tail_length > 0) {
+        const char* newline = (const char*) memchr(data, '\n', length);
+        size_t chunk = newline ? (size_t) (newline - data) : length;
+
+        if(parser->tail_length + chunk > parser->tail_capacity) {
+            size_t capacity = (parser->tail_length + chunk) * 2;
+
+            char* tail = (char*) realloc(parser->tail, capacity);
+            if(!tail)
+                return false;
+
+            parser->tail = tail;
+            parser->tail_capacity = capacity;
+        }
+
+        memcpy(parser->tail + parser->tail_length, data, chunk);
+        parser->tail_length += chunk;
+
+        if(!newline)
+            return true;
+
+        if(!goblin3d_parser_line(parser, parser->tail, parser->tail + parser->tail_length))
+            return false;
+
+        parser->tail_length = 0;
+        data = newline + 1;
+    }
+
+    while(data < end) {
+        const char* newline = (const char*) memchr(data, '\n', end - data);
+        if(!newline)
+            break;
+
+        if(!goblin3d_parser_line(parser, data, newline))
+            return false;
+        data = newline + 1;
+    }
+
+    if(data < end) {
+        size_t chunk = end - data;
+
+        if(chunk > parser->tail_capacity) {
+            char* tail = (char*) realloc(parser->tail, chunk * 2);
+            if(!tail)
+                return false;
+
+            parser->tail = tail;
+            parser->tail_capacity = chunk * 2;
+        }
+
+        memcpy(parser->tail, data, chunk);
+        parser->tail_length = chunk;
+    }
+
+    return true;
+}
+
+static bool goblin3d_parser_end_pass(goblin3d_obj_parser_t* parser) {
+    if(parser->tail_length > 0 &&
+        !goblin3d_parser_line(parser, parser->tail, parser->tail + parser->tail_length))
+        return false;
+
+    parser->tail_length = 0;
+    return true;
+}
+
+static bool goblin3d_parser_reserve(goblin3d_obj_parser_t* parser) {
+    goblin3d_obj_t* obj = parser->obj;
+
+    if(!goblin3d_parser_end_pass(parser))
+        return false;
+
+    free(parser->edge_keys);
+    parser->edge_keys = NULL;
+    parser->counting = false;
+
+    parser->point_capacity = obj->point_count;
+    parser->edge_capacity = obj->edge_count;
+    parser->face_capacity = obj->face_count;
+
+    obj->point_count = 0;
+    obj->edge_count = 0;
+    obj->face_count = 0;
+
+    obj->orig_points = (float(*)[3]) malloc(sizeof(float[3]) * (parser->point_capacity + 1));
+    obj->edges = (uint32_t(*)[2]) malloc(sizeof(uint32_t[2]) * (parser->edge_capacity + 1));
+    if(!obj->orig_points || !obj->edges)
+        return false;
+
+    if(parser->flags & GOBLIN3D_PARSE_KEEP_FACES) {
+        obj->edge_flags = (uint8_t*) malloc(parser->edge_capacity + 1);
+        if(!obj->edge_flags)
+            return false;
+    }
+
+    if(parser->face_capacity > 0) {
+        obj->faces = (uint32_t(*)[3]) malloc(sizeof(uint32_t[3]) * parser->face_capacity);
+        obj->face_edges = (uint32_t(*)[3]) malloc(sizeof(uint32_t[3]) * parser->face_capacity);
+
+        if(!obj->faces || !obj->face_edges)
+            return false;
+    }
+
+    uint8_t bits = 10;
+    while(((uint64_t) 1 << bits) <= (uint64_t) parser->edge_capacity * 2)
+        bits++;
+
+    return goblin3d_parser_rehash(parser, bits);
+}
+
+static bool goblin3d_parser_finish(goblin3d_obj_parser_t* parser) {
+    goblin3d_obj_t* obj = parser->obj;
+
+    if(!goblin3d_parser_end_pass(parser))
+        return false;
+    goblin3d_parser_free(parser);
+
+    if(obj->face_count == 0 && obj->edge_flags) {
+        free(obj->edge_flags);
+        obj->edge_flags = NULL;
+    }
+
+    if(obj->point_count < parser->point_capacity) {
+        float (*orig_points)[3] = (float(*)[3]) realloc(obj->orig_points, sizeof(float[3]) * (obj->point_count + 1));
+        if(orig_points)
+            obj->orig_points = orig_points;
+    }
+
+    if(obj->edge_count < parser->edge_capacity) {
+        uint32_t (*edges)[2] = (uint32_t(*)[2]) realloc(obj->edges, sizeof(uint32_t[2]) * (obj->edge_count + 1));
+        if(edges)
+            obj->edges = edges;
+
+        if(obj->edge_flags) {
+            uint8_t* edge_flags = (uint8_t*) realloc(obj->edge_flags, obj->edge_count + 1);
+            if(edge_flags)
+                obj->edge_flags = edge_flags;
+        }
+    }
+
+    if(obj->face_count < parser->face_capacity) {
+        uint32_t (*faces)[3] = (uint32_t(*)[3]) realloc(obj->faces, sizeof(uint32_t[3]) * (obj->face_count + 1));
+        if(faces)
+            obj->faces = faces;
+
+        uint32_t (*face_edges)[3] = (uint32_t(*)[3]) realloc(obj->face_edges, sizeof(uint32_t[3]) * (obj->face_count + 1));
+        if(face_edges)
+            obj->face_edges = face_edges;
+    }
+
+    obj->points = (float(*)[2]) malloc(sizeof(float[2]) * (obj->point_count + 1));
+    obj->rotated_points = (float(*)[3]) malloc(sizeof(float[3]) * (obj->point_count + 1));
+
+    return obj->points && obj->rotated_points &&
+        (!(parser->flags & GOBLIN3D_PARSE_WELD) || goblin3d_weld(obj, 0.0f));
+}
+
+static bool goblin3d_parser_fail(goblin3d_obj_parser_t* parser) {
+    goblin3d_parser_free(parser);
+    goblin3d_free(parser->obj);
+    goblin3d_init_empty(parser->obj);
+
+    return false;
+}
+
+bool goblin3d_parse_obj_buffer(const char* data, size_t length, goblin3d_obj_t* obj) {
+    return goblin3d_parse_obj_buffer_ex(data, length, obj, 0);
+}
+
+bool goblin3d_parse_obj_buffer_ex(const char* data, size_t length, goblin3d_obj_t* obj, uint8_t flags) {
+    goblin3d_obj_parser_t parser;
+    goblin3d_parser_init(&parser, obj, flags);
+
+    bool parsed = goblin3d_parser_feed(&parser, data, length);
+    if(parsed && parser.counting)
+        parsed = goblin3d_parser_reserve(&parser) &&
+            goblin3d_parser_feed(&parser, data, length);
+
+    if(!parsed || !goblin3d_parser_finish(&parser))
+        return goblin3d_parser_fail(&parser);
+    return true;
+}
+
+static bool goblin3d_reserve(void** array, uint32_t* capacity, uint32_t count, size_t size) {
+    if(count < *capacity)
+        return true;
+
+    uint32_t grown_capacity = *capacity * 2 + 64;
+    void* grown = realloc(*array, size * grown_capacity);
+    if(!grown)
+        return false;
+
+    *array = grown;
+    *capacity = grown_capacity;
+
+    return true;
+}
+
+#ifdef GOBLIN3D_POSIX
+
+typedef struct goblin3d_parse_job goblin3d_parse_job_t;
+
+typedef struct {
+    uint32_t first_corner;
+    uint32_t corner_count;
+    uint32_t points_before;
+    bool closed;
+} goblin3d_parse_polygon_t;
+
+typedef struct {
+    goblin3d_parse_job_t* job;
+    uint8_t index;
+    bool failed;
+
+    const char* begin;
+    const char* end;
+
+    float (*points)[3];
+    uint32_t point_count;
+    uint32_t point_capacity;
+
+    int64_t* corners;
+    uint32_t corner_count;
+    uint32_t corner_capacity;
+
+    goblin3d_parse_polygon_t* polygons;
+    uint32_t polygon_count;
+    uint32_t polygon_capacity;
+
+    uint32_t* indices;
+    uint32_t index_capacity;
+
+    uint64_t* keys;
+    uint32_t key_count;
+    uint32_t key_capacity;
+
+    uint32_t (*faces)[3];
+    uint8_t* face_sides;
+    uint32_t face_count;
+    uint32_t face_capacity;
+    uint32_t dropped_count;
+
+    uint32_t point_offset;
+    uint32_t face_offset;
+    uint32_t edge_offset;
+    uint32_t edge_count;
+    uint64_t key_low;
+    uint64_t key_high;
+
+    uint32_t* cursors;
+    uint8_t* heap;
+} goblin3d_parse_worker_t;
+
+struct goblin3d_parse_job {
+    goblin3d_obj_t* obj;
+    goblin3d_parse_worker_t* workers;
+    uint8_t thread_count;
+    uint8_t flags;
+    void (*phase)(goblin3d_parse_worker_t* worker);
+
+    pthread_t* threads;
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    uint32_t generation;
+    uint8_t started;
+    uint8_t pending;
+    bool stopping;
+};
+
+static int goblin3d_compare_edge_keys(const void* a, const void* b) {
+    uint64_t key_a = *(const uint64_t*) a, key_b = *(const uint64_t*) b;
+    return key_a < key_b ? -1 : (key_a > key_b ? 1 : 0);
+}
+
+static bool goblin3d_radix_sort(uint64_t* keys, uint32_t count) {
+    uint32_t histograms[8][256];
+    memset(histograms, 0, sizeof(histograms));
+
+    for(uint32_t i = 0; i < count; i++)
+        for(uint8_t digit = 0; digit < 8; digit++)
+            histograms[digit][(keys[i] >> (digit * 8)) & 0xFF]++;
+
+    uint64_t* temp = (uint64_t*) malloc(sizeof(uint64_t) * (count + 1));
+    if(!temp)
+        return false;
+
+    uint64_t* source = keys;
+    uint64_t* target = temp;
+
+    for(uint8_t digit = 0; digit < 8; digit++) {
+        uint32_t* histogram = histograms[digit];
+        if(histogram[(source[0] >> (digit * 8)) & 0xFF] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for(uint32_t i = 0; i < 256; i++) {
+            uint32_t bucket = histogram[i];
+
+            histogram[i] = offset;
+            offset += bucket;
+        }
+
+        for(uint32_t i = 0; i < count; i++)
+            target[histogram[(source[i] >> (digit * 8)) & 0xFF]++] = source[i];
+
+        uint64_t* swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if(source != keys)
+        memcpy(keys, source, sizeof(uint64_t) * count);
+
+    free(temp);
+    return true;
+}
+
+static uint32_t goblin3d_lower_bound(const uint64_t* keys, uint32_t count, uint64_t key) {
+    uint32_t lo = 0, hi = count;
+
+    while(lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if(keys[mid] < key)
+            lo = mid + 1;
+        else hi = mid;
+    }
+
+    return lo;
+}
+
+static bool goblin3d_parse_scan_line(goblin3d_parse_worker_t* worker, const char* cursor, const char* end) {
+    cursor = goblin3d_skip_spaces(cursor, end);
+    if(end - cursor < 2 || (cursor[1] != ' ' && cursor[1] != '\t'))
+        return true;
+
+    char type = *cursor;
+    cursor += 2;
+
+    if(type == 'v') {
+        float x, y, z;
+
+        if(!(cursor = goblin3d_parse_float(cursor, end, &x)) ||
+            !(cursor = goblin3d_parse_float(cursor, end, &y)) ||
+            !(cursor = goblin3d_parse_float(cursor, end, &z)))
+            return true;
+
+        if(!goblin3d_reserve((void**) &worker->points, &worker->point_capacity,
+            worker->point_count, sizeof(float[3])))
+            return false;
+
+        worker->points[worker->point_count][0] = x;
+        worker->points[worker->point_count][1] = y;
+        worker->points[worker->point_count++][2] = z;
+
+        return true;
+    }
+
+    if(type != 'f' && type != 'l')
+        return true;
+
+    uint32_t first = worker->corner_count;
+    int64_t index;
+
+    while((cursor = goblin3d_parse_index(cursor, end, &index)) != NULL) {
+        if(!goblin3d_reserve((void**) &worker->corners, &worker->corner_capacity,
+            worker->corner_count, sizeof(int64_t)))
+            return false;
+
+        worker->corners[worker->corner_count++] = index;
+    }
+
+    if(worker->corner_count - first < 2) {
+        worker->corner_count = first;
+        return true;
+    }
+
+    if(!goblin3d_reserve((void**) &worker->polygons, &worker->polygon_capacity,
+        worker->polygon_count, sizeof(goblin3d_parse_polygon_t)))
+        return false;
+
+    goblin3d_parse_polygon_t* polygon = &worker->polygons[worker->polygon_count++];
+    polygon->first_corner = first;
+    polygon->corner_count = worker->corner_count - first;
+    polygon->points_before = worker->point_count;
+    polygon->closed = type == 'f';
+
+    return true;
+}
+
+static void goblin3d_parse_scan_phase(goblin3d_parse_worker_t* worker) {
+    const char* data = worker->begin;
+
+    while(data < worker->end) {
+        const char* newline = (const char*) memchr(data, '\n', worker->end - data);
+        const char* line_end = newline ? newline : worker->end;
+
+        if(!goblin3d_parse_scan_line(worker, data, line_end)) {
+            worker->failed = true;
+            return;
+        }
+
+        data = line_end + 1;
+    }
+}
+
+static bool goblin3d_parse_emit_edge(goblin3d_parse_worker_t* worker, uint32_t v1, uint32_t v2) {
+    if(v1 == v2)
+        return true;
+
+    if(!goblin3d_reserve((void**) &worker->keys, &worker->key_capacity,
+        worker->key_count, sizeof(uint64_t)))
+        return false;
+
+    worker->keys[worker->key_count++] = v1 < v2 ?
+        ((uint64_t) v1 << 32) | v2 : ((uint64_t) v2 << 32) | v1;
+    return true;
+}
+
+static bool goblin3d_parse_emit_polygon(goblin3d_parse_worker_t* worker, goblin3d_parse_polygon_t* polygon) {
+    uint32_t count = polygon->corner_count;
+    int64_t point_count = (int64_t) worker->point_offset + polygon->points_before;
+
+    if(count > worker->index_capacity) {
+        uint32_t* grown = (uint32_t*) realloc(worker->indices, sizeof(uint32_t) * count * 2);
+        if(!grown)
+            return false;
+
+        worker->indices = grown;
+        worker->index_capacity = count * 2;
+    }
+    uint32_t* indices = worker->indices;
+
+    for(uint32_t i = 0; i < count; i++) {
+        int64_t index = worker->corners[polygon->first_corner + i];
+        if(index < 0)
+            index += point_count;
+        else index--;
+
+        if(index < 0 || index >= point_count) {
+            worker->dropped_count++;
+            return true;
+        }
+        indices[i] = (uint32_t) index;
+    }
+
+    uint32_t sides = polygon->closed ? count : count - 1;
+    for(uint32_t i = 0; i < sides; i++)
+        if(!goblin3d_parse_emit_edge(worker, indices[i], indices[(i + 1) % count]))
+            return false;
+
+    if(!polygon->closed || count < 3 || !(worker->job->flags & GOBLIN3D_PARSE_KEEP_FACES))
+        return true;
+
+    bool degenerate = false;
+    for(uint32_t i = 1; i < count - 1; i++) {
+        if(indices[0] == indices[i] || indices[i] == indices[i + 1] || indices[i + 1] == indices[0]) {
+            degenerate = true;
+            continue;
+        }
+
+        uint32_t capacity = worker->face_capacity;
+        if(!goblin3d_reserve((void**) &worker->faces, &capacity, worker->face_count, sizeof(uint32_t[3])))
+            return false;
+
+        if(capacity != worker->face_capacity) {
+            uint8_t* face_sides = (uint8_t*) realloc(worker->face_sides, capacity);
+            if(!face_sides)
+                return false;
+
+            worker->face_sides = face_sides;
+            worker->face_capacity = capacity;
+        }
+
+        uint32_t face = worker->face_count++;
+        worker->faces[face][0] = indices[0];
+        worker->faces[face][1] = indices[i];
+        worker->faces[face][2] = indices[i + 1];
+        worker->face_sides[face] = (i == 1 ? 0x01 : 0) | 0x02 | (i == count - 2 ? 0x04 : 0);
+    }
+
+    if(degenerate)
+        worker->dropped_count++;
+
+    return true;
+}
+
+static void goblin3d_parse_emit_phase(goblin3d_parse_worker_t* worker) {
+    for(uint32_t i = 0; i < worker->polygon_count; i++)
+        if(!goblin3d_parse_emit_polygon(worker, &worker->polygons[i])) {
+            worker->failed = true;
+            return;
+        }
+
+    free(worker->corners);
+    free(worker->polygons);
+    free(worker->indices);
+
+    worker->corners = NULL;
+    worker->polygons = NULL;
+    worker->indices = NULL;
+
+    if(worker->key_count > 0 && !goblin3d_radix_sort(worker->keys, worker->key_count)) {
+        worker->failed = true;
+        return;
+    }
+
+    uint32_t unique = 0;
+    for(uint32_t i = 0; i < worker->key_count; i++)
+        if(unique == 0 || worker->keys[unique - 1] != worker->keys[i])
+            worker->keys[unique++] = worker->keys[i];
+    worker->key_count = unique;
+}
+
+static inline uint64_t goblin3d_parse_head(goblin3d_parse_worker_t* worker, uint8_t source) {
+    return worker->job->workers[source].keys[worker->cursors[source]];
+}
+
+static void goblin3d_parse_sift(goblin3d_parse_worker_t* worker, uint32_t size, uint32_t i) {
+    uint8_t* heap = worker->heap;
+    uint8_t source = heap[i];
+    uint64_t key = goblin3d_parse_head(worker, source);
+
+    while(i * 2 + 1 < size) {
+        uint32_t child = i * 2 + 1;
+        if(child + 1 < size && goblin3d_parse_head(worker, heap[child + 1]) < goblin3d_parse_head(worker, heap[child]))
+            child++;
+
+        if(goblin3d_parse_head(worker, heap[child]) >= key)
+            break;
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = source;
+}
+
+static uint32_t goblin3d_parse_merge(goblin3d_parse_worker_t* worker, uint32_t (*edges)[2]) {
+    goblin3d_parse_job_t* job = worker->job;
+    uint32_t* cursors = worker->cursors;
+    uint32_t* ends = worker->cursors + job->thread_count;
+    uint32_t size = 0;
+
+    for(uint8_t i = 0; i < job->thread_count; i++) {
+        goblin3d_parse_worker_t* source = &job->workers[i];
+
+        cursors[i] = goblin3d_lower_bound(source->keys, source->key_count, worker->key_low);
+        ends[i] = goblin3d_lower_bound(source->keys, source->key_count, worker->key_high);
+
+        if(cursors[i] < ends[i])
+            worker->heap[size++] = i;
+    }
+
+    for(uint32_t i = size / 2; i-- > 0;)
+        goblin3d_parse_sift(worker, size, i);
+
+    uint32_t count = 0;
+    uint64_t last = 0;
+
+    while(size > 0) {
+        uint8_t source = worker->heap[0];
+        uint64_t smallest = goblin3d_parse_head(worker, source);
+
+        if(++cursors[source] == ends[source])
+            worker->heap[0] = worker->heap[--size];
+        if(size > 0)
+            goblin3d_parse_sift(worker, size, 0);
+
+        if(count > 0 && smallest == last)
+            continue;
+
+        if(edges) {
+            edges[count][0] = (uint32_t) (smallest >> 32);
+            edges[count][1] = (uint32_t) smallest;
+        }
+
+        last = smallest;
+        count++;
+    }
+
+    return count;
+}
+
+static void goblin3d_parse_count_phase(goblin3d_parse_worker_t* worker) {
+    worker->edge_count = goblin3d_parse_merge(worker, NULL);
+}
+
+static void goblin3d_parse_write_phase(goblin3d_parse_worker_t* worker) {
+    goblin3d_obj_t* obj = worker->job->obj;
+
+    goblin3d_parse_merge(worker, obj->edges + worker->edge_offset);
+    if(worker->point_count > 0)
+        memcpy(obj->orig_points + worker->point_offset, worker->points, sizeof(float[3]) * worker->point_count);
+
+    if(worker->face_count > 0)
+        memcpy(obj->faces + worker->face_offset, worker->faces, sizeof(uint32_t[3]) * worker->face_count);
+}
+
+static void goblin3d_parse_face_edge_phase(goblin3d_parse_worker_t* worker) {
+    goblin3d_obj_t* obj = worker->job->obj;
+
+    for(uint32_t i = 0; i < worker->face_count; i++) {
+        uint32_t face = worker->face_offset + i;
+
+        for(uint8_t j = 0; j < 3; j++)
+            obj->face_edges[face][j] = (worker->face_sides[i] & (1 << j)) ?
+                goblin3d_search_edge(obj->edges, obj->edge_count,
+                    obj->faces[face][j], obj->faces[face][(j + 1) % 3]) :
+                GOBLIN3D_NO_EDGE;
+    }
+}
+
+static void* goblin3d_parse_thread(void* arg) {
+    goblin3d_parse_worker_t* worker = (goblin3d_parse_worker_t*) arg;
+    goblin3d_parse_job_t* job = worker->job;
+    uint32_t generation = 0;
+
+    pthread_mutex_lock(&job->lock);
+    while(true) {
+        while(job->generation == generation && !job->stopping)
+            pthread_cond_wait(&job->start, &job->lock);
+
+        if(job->stopping)
+            break;
+
+        generation = job->generation;
+        pthread_mutex_unlock(&job->lock);
+
+        job->phase(worker);
+
+        pthread_mutex_lock(&job->lock);
+        if(--job->pending == 0)
+            pthread_cond_signal(&job->done);
+    }
+    pthread_mutex_unlock(&job->lock);
+
+    return NULL;
+}
+
+static bool goblin3d_parse_start(goblin3d_parse_job_t* job) {
+    job->threads = (pthread_t*) malloc(sizeof(pthread_t) * job->thread_count);
+    if(!job->threads)
+        return false;
+
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->start, NULL);
+    pthread_cond_init(&job->done, NULL);
+
+    for(job->started = 1; job->started < job->thread_count; job->started++)
+        if(pthread_create(&job->threads[job->started], NULL, goblin3d_parse_thread,
+            &job->workers[job->started]) != 0)
+            return false;
+
+    return true;
+}
+
+static void goblin3d_parse_stop(goblin3d_parse_job_t* job) {
+    if(!job->threads)
+        return;
+
+    pthread_mutex_lock(&job->lock);
+    job->stopping = true;
+    pthread_cond_broadcast(&job->start);
+    pthread_mutex_unlock(&job->lock);
+
+    for(uint8_t i = 1; i < job->started; i++)
+        pthread_join(job->threads[i], NULL);
+
+    pthread_cond_destroy(&job->done);
+    pthread_cond_destroy(&job->start);
+    pthread_mutex_destroy(&job->lock);
+
+    free(job->threads);
+    job->threads = NULL;
+}
+
+static bool goblin3d_parse_run(goblin3d_parse_job_t* job, void (*phase)(goblin3d_parse_worker_t*)) {
+    job->phase = phase;
+
+    pthread_mutex_lock(&job->lock);
+    job->pending = job->thread_count - 1;
+    job->generation++;
+    pthread_cond_broadcast(&job->start);
+    pthread_mutex_unlock(&job->lock);
+
+    phase(&job->workers[0]);
+
+    pthread_mutex_lock(&job->lock);
+    while(job->pending > 0)
+        pthread_cond_wait(&job->done, &job->lock);
+    pthread_mutex_unlock(&job->lock);
+
+    for(uint8_t i = 0; i < job->thread_count; i++)
+        if(job->workers[i].failed)
+            return false;
+
+    return true;
+}
+
+static void goblin3d_parse_job_free(goblin3d_parse_job_t* job) {
+    for(uint8_t i = 0; i < job->thread_count; i++) {
+        goblin3d_parse_worker_t* worker = &job->workers[i];
+
+        free(worker->points);
+        free(worker->corners);
+        free(worker->polygons);
+        free(worker->indices);
+        free(worker->keys);
+        free(worker->faces);
+        free(worker->face_sides);
+        free(worker->cursors);
+        free(worker->heap);
+    }
+
+    free(job->workers);
+}
+
+static bool goblin3d_parse_partition(goblin3d_parse_job_t* job) {
+    uint8_t count = job->thread_count;
+    uint32_t sample_count = 0;
+
+    uint64_t* samples = (uint64_t*) malloc(sizeof(uint64_t) * ((uint32_t) count * count + 1));
+    if(!samples)
+        return false;
+
+    for(uint8_t i = 0; i < count; i++) {
+        goblin3d_parse_worker_t* worker = &job->workers[i];
+
+        for(uint8_t j = 1; j < count && worker->key_count > 0; j++)
+            samples[sample_count++] = worker->keys[(uint64_t) worker->key_count * j / count];
+    }
+    qsort(samples, sample_count, sizeof(uint64_t), goblin3d_compare_edge_keys);
+
+    for(uint8_t i = 0; i < count; i++) {
+        job->workers[i].key_low = i == 0 ? 0 : job->workers[i - 1].key_high;
+        job->workers[i].key_high = i == count - 1 || sample_count == 0 ? UINT64_MAX :
+            samples[(uint64_t) sample_count * (i + 1) / count];
+
+        if(job->workers[i].key_high < job->workers[i].key_low)
+            job->workers[i].key_high = job->workers[i].key_low;
+    }
+
+    free(samples);
+    return true;
+}
+
+static bool goblin3d_parse_allocate(goblin3d_parse_job_t* job) {
+    goblin3d_obj_t* obj = job->obj;
+
+    for(uint8_t i = 0; i < job->thread_count; i++) {
+        goblin3d_parse_worker_t* worker = &job->workers[i];
+
+        worker->edge_offset = obj->edge_count;
+        worker->face_offset = obj->face_count;
+
+        obj->edge_count += worker->edge_count;
+        obj->face_count += worker->face_count;
+        obj->dropped_count += worker->dropped_count;
+    }
+
+    obj->orig_points = (float(*)[3]) malloc(sizeof(float[3]) * (obj->point_count + 1));
+    obj->rotated_points = (float(*)[3]) malloc(sizeof(float[3]) * (obj->point_count + 1));
+    obj->points = (float(*)[2]) malloc(sizeof(float[2]) * (obj->point_count + 1));
+    obj->edges = (uint32_t(*)[2]) malloc(sizeof(uint32_t[2]) * (obj->edge_count + 1));
+
+    if(!obj->orig_points || !obj->rotated_points || !obj->points || !obj->edges)
+        return false;
+
+    if(obj->face_count == 0)
+        return true;
+
+    obj->faces = (uint32_t(*)[3]) malloc(sizeof(uint32_t[3]) * obj->face_count);
+    obj->face_edges = (uint32_t(*)[3]) malloc(sizeof(uint32_t[3]) * obj->face_count);
+    obj->edge_flags = (uint8_t*) calloc(obj->edge_count + 1, 1);
+
+    return obj->faces && obj->face_edges && obj->edge_flags;
+}
+
+bool goblin3d_parse_obj_buffer_parallel(const char* data, size_t length, goblin3d_obj_t* obj,
+    uint8_t flags, uint8_t thread_count) {
+    goblin3d_parse_job_t job;
+    memset(&job, 0, sizeof(goblin3d_parse_job_t));
+
+    job.obj = obj;
+    job.thread_count = thread_count > 0 ? thread_count : 1;
+    job.flags = flags;
+
+    goblin3d_init_empty(obj);
+    goblin3d_parse_worker_t* workers = (goblin3d_parse_worker_t*)
+        calloc(job.thread_count, sizeof(goblin3d_parse_worker_t));
+    if(!workers)
+        return false;
+    job.workers = workers;
+
+    bool success = true;
+    const char* end = data + length;
+
+    for(uint8_t i = 0; i < job.thread_count; i++) {
+        workers[i].job = &job;
+        workers[i].index = i;
+        workers[i].cursors = (uint32_t*) malloc(sizeof(uint32_t) * 2 * job.thread_count);
+        workers[i].heap = (uint8_t*) malloc(job.thread_count);
+
+        if(!workers[i].cursors || !workers[i].heap)
+            success = false;
+
+        const char* begin = i == 0 ? data : workers[i - 1].end;
+        const char* split = data + length / job.thread_count * (i + 1);
+
+        if(i == job.thread_count - 1 || split <= begin)
+            split = i == job.thread_count - 1 ? end : begin;
+        else {
+            const char* newline = (const char*) memchr(split, '\n', end - split);
+            split = newline ? newline + 1 : end;
+        }
+
+        workers[i].begin = begin;
+        workers[i].end = split;
+    }
+
+    success = success && goblin3d_parse_start(&job) && goblin3d_parse_run(&job, goblin3d_parse_scan_phase);
+    if(success) {
+        for(uint8_t i = 0; i < job.thread_count; i++) {
+            workers[i].point_offset = obj->point_count;
+            obj->point_count += workers[i].point_count;
+        }
+
+        success = goblin3d_parse_run(&job, goblin3d_parse_emit_phase) &&
+            goblin3d_parse_partition(&job) &&
+            goblin3d_parse_run(&job, goblin3d_parse_count_phase) &&
+            goblin3d_parse_allocate(&job) &&
+            goblin3d_parse_run(&job, goblin3d_parse_write_phase) &&
+            goblin3d_parse_run(&job, goblin3d_parse_face_edge_phase);
+    }
+
+    if(success)
+        for(uint32_t i = 0; i < obj->face_count; i++)
+            for(uint8_t j = 0; j < 3; j++)
+                if(obj->face_edges[i][j] != GOBLIN3D_NO_EDGE)
+                    obj->edge_flags[obj->face_edges[i][j]] |= GOBLIN3D_EDGE_HAS_FACE;
+
+    goblin3d_parse_stop(&job);
+    goblin3d_parse_job_free(&job);
+    if(success && (flags & GOBLIN3D_PARSE_WELD))
+        success = goblin3d_weld(obj, 0.0f);
+
+    if(!success) {
+        goblin3d_free(obj);
+        goblin3d_init_empty(obj);
+    }
+
+    return success;
+}
+
+typedef struct {
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t source_hash;
+    uint32_t parse_flags;
+    char magic[4];
+} goblin3d_cache_key_t;
+
+static uint64_t goblin3d_hash_bytes(const char* data, size_t length) {
+    uint64_t hash = length * 0x9E3779B97F4A7C15ull, word;
+    size_t i = 0;
+
+    for(; i + 8 <= length; i += 8) {
+        memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+
+    for(; i < length; i++)
+        hash = (hash ^ (uint8_t) data[i]) * 0x100000001B3ull;
+
+    return hash ^ (hash >> 29);
+}
+
+static bool goblin3d_load_cache(const char* cache_name, const goblin3d_cache_key_t* key, goblin3d_obj_t* obj) {
+    const char* data;
+    size_t size;
+
+    if(!goblin3d_map_file(cache_name, &data, &size))
+        return false;
+
+    bool loaded = size > sizeof(goblin3d_cache_key_t) &&
+        memcmp(data + size - sizeof(goblin3d_cache_key_t), key, sizeof(goblin3d_cache_key_t)) == 0 &&
+        goblin3d_load_binary_buffer(data, size - sizeof(goblin3d_cache_key_t), obj);
+
+    if(loaded && obj->borrowed) {
+        obj->mapping = data;
+        obj->mapping_size = size;
+    }
+    else goblin3d_unmap_file(data, size);
+
+    return loaded;
+}
+
+static void goblin3d_save_cache(goblin3d_obj_t* obj, const char* cache_name, const goblin3d_cache_key_t* key) {
+    size_t length = strlen(cache_name);
+    char* temp_name = (char*) malloc(length + 5);
+    if(!temp_name)
+        return;
+
+    memcpy(temp_name, cache_name, length);
+    memcpy(temp_name + length, ".tmp", 5);
+
+    bool saved = goblin3d_save_binary(obj, temp_name, 0);
+    if(saved) {
+        FILE* file = fopen(temp_name, "ab");
+
+        saved = file && fwrite(key, sizeof(goblin3d_cache_key_t), 1, file) == 1;
+        saved = file && fclose(file) == 0 && saved;
+    }
+
+    if(!saved || rename(temp_name, cache_name) != 0)
+        unlink(temp_name);
+    free(temp_name);
+}
+
+static char* goblin3d_cache_name(const char* filename) {
+    size_t length = strlen(filename);
+    char* cache_name = (char*) malloc(length + sizeof(GOBLIN3D_CACHE_SUFFIX));
+    if(!cache_name)
+        return NULL;
+
+    memcpy(cache_name, filename, length);
+    memcpy(cache_name + length, GOBLIN3D_CACHE_SUFFIX, sizeof(GOBLIN3D_CACHE_SUFFIX));
+
+    return cache_name;
+}
+
+static void goblin3d_cache_key(goblin3d_cache_key_t* key, const char* data, size_t size,
+    const struct stat* info, uint8_t flags) {
+    memset(key, 0, sizeof(goblin3d_cache_key_t));
+
+    key->source_size = size;
+    key->source_mtime = info->st_mtime;
+    key->source_hash = goblin3d_hash_bytes(data, size);
+    key->parse_flags = flags & (GOBLIN3D_PARSE_KEEP_FACES | GOBLIN3D_PARSE_WELD);
+    memcpy(key->magic, "G3DC", 4);
+}
+
+static bool goblin3d_parse_obj_cached(const char* filename, goblin3d_obj_t* obj,
+    uint8_t flags, uint8_t thread_count) {
+    const char* data;
+    size_t size;
+    struct stat info;
+
+    if(stat(filename, &info) != 0 || !goblin3d_map_file(filename, &data, &size))
+        return goblin3d_parse_obj_file_ex(filename, obj, flags);
+
+    char* cache_name = goblin3d_cache_name(filename);
+    if(!cache_name) {
+        goblin3d_unmap_file(data, size);
+        return false;
+    }
+
+    goblin3d_cache_key_t key;
+    goblin3d_cache_key(&key, data, size, &info, flags);
+
+    bool parsed = goblin3d_load_cache(cache_name, &key, obj);
+    if(!parsed) {
+        parsed = thread_count > 1 ?
+            goblin3d_parse_obj_buffer_parallel(data, size, obj, flags, thread_count) :
+            goblin3d_parse_obj_buffer_ex(data, size, obj, flags);
+
+        if(parsed)
+            goblin3d_save_cache(obj, cache_name, &key);
+    }
+
+    goblin3d_unmap_file(data, size);
+    free(cache_name);
+
+    return parsed;
+}
+
+bool goblin3d_parse_obj_file_parallel(const char* filename, goblin3d_obj_t* obj,
+    uint8_t flags, uint8_t thread_count) {
+    const char* data;
+    size_t size;
+
+    if(flags & GOBLIN3D_PARSE_CACHE)
+        return goblin3d_parse_obj_cached(filename, obj, flags & ~GOBLIN3D_PARSE_CACHE, thread_count);
+
+    if(!goblin3d_map_file(filename, &data, &size))
+        return goblin3d_parse_obj_file_ex(filename, obj, flags & ~GOBLIN3D_PARSE_MMAP);
+
+    bool parsed = goblin3d_parse_obj_buffer_parallel(data, size, obj, flags, thread_count);
+    goblin3d_unmap_file(data, size);
+
+    return parsed;
+}
+
+#endif
+
+bool goblin3d_parse_obj_file(const char* filename, goblin3d_obj_t* obj) {
+    return goblin3d_parse_obj_file_ex(filename, obj, 0);
+}
+
+bool goblin3d_parse_obj_file_ex(const char* filename, goblin3d_obj_t* obj, uint8_t flags) {
+    goblin3d_obj_parser_t parser;
+
+    #ifdef ARDUINO
+    static char block[GOBLIN3D_PARSE_BLOCK_SIZE];
+
+    File file = SD.open(filename);
+    if(!file)
+        return false;
+    goblin3d_parser_init(&parser, obj, flags);
+
+    bool parsed = true;
+    while(parsed) {
+        int length;
+        while(parsed && (length = file.read((uint8_t*) block, sizeof(block))) > 0)
+            parsed = goblin3d_parser_feed(&parser, block, length);
+
+        if(!parsed || !parser.counting)
+            break;
+
+        parsed = goblin3d_parser_reserve(&parser) && file.seek(0);
+    }
+
+    file.close();
+    if(!parsed || !goblin3d_parser_finish(&parser))
+        return goblin3d_parser_fail(&parser);
+
+    return true;
+
+    #else
+
+    #ifdef GOBLIN3D_POSIX
+    const char* data;
+    size_t size;
+
+    if(flags & GOBLIN3D_PARSE_CACHE)
+        return goblin3d_parse_obj_cached(filename, obj, flags & ~GOBLIN3D_PARSE_CACHE, 1);
+
+    if((flags & GOBLIN3D_PARSE_MMAP) && goblin3d_map_file(filename, &data, &size)) {
+        bool parsed = goblin3d_parse_obj_buffer_ex(data, size, obj, flags);
+        goblin3d_unmap_file(data, size);
+
+        return parsed;
+    }
+    #endif
+
+    FILE* file = fopen(filename, "rb");
+    if(!file)
+        return false;
+
+    char* block = (char*) malloc(GOBLIN3D_PARSE_BLOCK_SIZE);
+    if(!block) {
+        fclose(file);
+        return false;
+    }
+    goblin3d_parser_init(&parser, obj, flags);
+
+    bool parsed = true;
+    while(parsed) {
+        size_t length;
+        while(parsed && (length = fread(block, 1, GOBLIN3D_PARSE_BLOCK_SIZE, file)) > 0)
+            parsed = goblin3d_parser_feed(&parser, block, length);
+
+        if(!parsed || !parser.counting)
+            break;
+
+        parsed = goblin3d_parser_reserve(&parser) && fseek(file, 0, SEEK_SET) == 0;
+    }
+
+    free(block);
+    fclose(file);
+
+    if(!parsed || !goblin3d_parser_finish(&parser))
+        return goblin3d_parser_fail(&parser);
+    return true;
+
+    #endif
+}
+
+typedef struct {
+    goblin3d_obj_parser_t parser;
+    char block[GOBLIN3D_PARSE_BLOCK_SIZE];
+
+    #ifdef ARDUINO
+    File* file;
+    #else
+    FILE* file;
+    #endif
+
+    size_t position;
+    size_t total;
+
+    #ifdef GOBLIN3D_POSIX
+    pthread_t thread;
+    bool threaded;
+    bool cancel;
+    char* filename;
+    #endif
+} goblin3d_load_state_t;
+
+static inline void goblin3d_load_set(uint8_t* field, uint8_t value) {
+    #ifdef GOBLIN3D_POSIX
+    __atomic_store_n(field, value, __ATOMIC_RELEASE);
+    #else
+    *field = value;
+    #endif
+}
+
+static inline uint8_t goblin3d_load_get(uint8_t* field) {
+    #ifdef GOBLIN3D_POSIX
+    return __atomic_load_n(field, __ATOMIC_ACQUIRE);
+    #else
+    return *field;
+    #endif
+}
+
+static uint32_t goblin3d_millis() {
+    #ifdef ARDUINO
+    return millis();
+    #elif defined(GOBLIN3D_POSIX)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t) (now.tv_sec * 1000 + now.tv_nsec / 1000000);
+    #else
+    return (uint32_t) ((uint64_t) clock() * 1000 / CLOCKS_PER_SEC);
+    #endif
+}
+
+static void goblin3d_load_close(goblin3d_load_state_t* state) {
+    if(!state->file)
+        return;
+
+    #ifdef ARDUINO
+    state->file->close();
+    delete state->file;
+    #else
+    fclose(state->file);
+    #endif
+
+    state->file = NULL;
+}
+
+static bool goblin3d_load_open(goblin3d_loader_t* loader, const char* filename, uint8_t flags) {
+    goblin3d_load_state_t* state = (goblin3d_load_state_t*) malloc(sizeof(goblin3d_load_state_t));
+    if(!state)
+        return false;
+
+    memset(state, 0, sizeof(goblin3d_load_state_t));
+    loader->state = state;
+    loader->percent = 0;
+    loader->status = GOBLIN3D_LOAD_IDLE;
+
+    #ifdef ARDUINO
+    File file = SD.open(filename);
+    if(file)
+        state->file = new File(file);
+    if(state->file)
+        state->total = state->file->size();
+    #else
+    state->file = fopen(filename, "rb");
+    if(state->file && fseek(state->file, 0, SEEK_END) == 0) {
+        long size = ftell(state->file);
+
+        state->total = size > 0 ? (size_t) size : 0;
+        if(fseek(state->file, 0, SEEK_SET) != 0)
+            goblin3d_load_close(state);
+    }
+    #endif
+
+    if(!state->file) {
+        free(state);
+        loader->state = NULL;
+        return false;
+    }
+
+    goblin3d_parser_init(&state->parser, &loader->result, flags);
+    if(state->parser.counting)
+        state->total *= 2;
+
+    loader->status = GOBLIN3D_LOAD_RUNNING;
+    return true;
+}
+
+static uint8_t goblin3d_load_block(goblin3d_loader_t* loader) {
+    goblin3d_load_state_t* state = (goblin3d_load_state_t*) loader->state;
+
+    #ifdef ARDUINO
+    int read = state->file->read((uint8_t*) state->block, sizeof(state->block));
+    bool failed = read < 0;
+    size_t length = read > 0 ? (size_t) read : 0;
+    #else
+    size_t length = fread(state->block, 1, sizeof(state->block), state->file);
+    bool failed = length == 0 && ferror(state->file);
+    #endif
+
+    bool parsed = !failed;
+    if(parsed && length > 0) {
+        state->position += length;
+        parsed = goblin3d_parser_feed(&state->parser, state->block, length);
+
+        if(parsed && state->total > 0) {
+            uint32_t percent = (uint64_t) state->position * 100 / state->total;
+            goblin3d_load_set(&loader->percent, percent < 99 ? percent : 99);
+        }
+
+        if(parsed)
+            return GOBLIN3D_LOAD_RUNNING;
+    }
+    else if(parsed && state->parser.counting) {
+        #ifdef ARDUINO
+        parsed = goblin3d_parser_reserve(&state->parser) && state->file->seek(0);
+        #else
+        parsed = goblin3d_parser_reserve(&state->parser) && fseek(state->file, 0, SEEK_SET) == 0;
+        #endif
+
+        if(parsed)
+            return GOBLIN3D_LOAD_RUNNING;
+    }
+    else if(parsed)
+        parsed = goblin3d_parser_finish(&state->parser);
+
+    goblin3d_load_close(state);
+    if(!parsed) {
+        goblin3d_parser_fail(&state->parser);
+        return GOBLIN3D_LOAD_FAILED;
+    }
+
+    goblin3d_load_set(&loader->percent, 100);
+    return GOBLIN3D_LOAD_DONE;
+}
+
+bool goblin3d_load_begin(goblin3d_loader_t* loader, const char* filename, uint8_t flags) {
+    return goblin3d_load_open(loader, filename, flags & ~(GOBLIN3D_PARSE_MMAP | GOBLIN3D_PARSE_CACHE));
+}
+
+uint8_t goblin3d_load_step(goblin3d_loader_t* loader, uint32_t budget_ms) {
+    uint8_t status = goblin3d_load_get(&loader->status);
+    if(status != GOBLIN3D_LOAD_RUNNING)
+        return status;
+
+    #ifdef GOBLIN3D_POSIX
+    if(((goblin3d_load_state_t*) loader->state)->threaded)
+        return status;
+    #endif
+
+    uint32_t start = goblin3d_millis();
+
+    do status = goblin3d_load_block(loader);
+    while(status == GOBLIN3D_LOAD_RUNNING && goblin3d_millis() - start < budget_ms);
+
+    goblin3d_load_set(&loader->status, status);
+    return status;
+}
+
+#ifdef GOBLIN3D_POSIX
+
+static void* goblin3d_load_thread(void* argument) {
+    goblin3d_loader_t* loader = (goblin3d_loader_t*) argument;
+    goblin3d_load_state_t* state = (goblin3d_load_state_t*) loader->state;
+
+    goblin3d_cache_key_t key;
+    char* cache_name = NULL;
+
+    const char* data;
+    size_t size;
+    struct stat info;
+
+    if(state->filename && stat(state->filename, &info) == 0 && goblin3d_map_file(state->filename, &data, &size)) {
+        goblin3d_cache_key(&key, data, size, &info, state->parser.flags);
+        goblin3d_unmap_file(data, size);
+
+        cache_name = goblin3d_cache_name(state->filename);
+    }
+
+    uint8_t status = GOBLIN3D_LOAD_RUNNING;
+    bool cached = cache_name && goblin3d_load_cache(cache_name, &key, &loader->result);
+
+    if(cached) {
+        goblin3d_load_close(state);
+        goblin3d_load_set(&loader->percent, 100);
+
+        status = GOBLIN3D_LOAD_DONE;
+    }
+
+    while(status == GOBLIN3D_LOAD_RUNNING && !__atomic_load_n(&state->cancel, __ATOMIC_RELAXED))
+        status = goblin3d_load_block(loader);
+
+    if(status == GOBLIN3D_LOAD_DONE && cache_name && !cached)
+        goblin3d_save_cache(&loader->result, cache_name, &key);
+    free(cache_name);
+
+    goblin3d_load_set(&loader->status, status);
+    return NULL;
+}
+
+bool goblin3d_load_start(goblin3d_loader_t* loader, const char* filename, uint8_t flags) {
+    flags &= ~GOBLIN3D_PARSE_MMAP;
+
+    if(!goblin3d_load_open(loader, filename, flags & ~GOBLIN3D_PARSE_CACHE))
+        return false;
+
+    goblin3d_load_state_t* state = (goblin3d_load_state_t*) loader->state;
+    if(flags & GOBLIN3D_PARSE_CACHE)
+        state->filename = strdup(filename);
+
+    if((flags & GOBLIN3D_PARSE_CACHE) && !state->filename) {
+        goblin3d_load_cancel(loader);
+        return false;
+    }
+
+    state->threaded = true;
+    if(pthread_create(&state->thread, NULL, goblin3d_load_thread, loader) != 0) {
+        state->threaded = false;
+        goblin3d_load_cancel(loader);
+        return false;
+    }
+
+    return true;
+}
+
+#endif
+
+uint8_t goblin3d_load_status(goblin3d_loader_t* loader, uint8_t* percent) {
+    if(percent)
+        *percent = goblin3d_load_get(&loader->percent);
+
+    return goblin3d_load_get(&loader->status);
+}
+
+static void goblin3d_load_release(goblin3d_loader_t* loader) {
+    goblin3d_load_state_t* state = (goblin3d_load_state_t*) loader->state;
+    if(!state)
+        return;
+
+    #ifdef GOBLIN3D_POSIX
+    if(state->threaded) {
+        __atomic_store_n(&state->cancel, true, __ATOMIC_RELAXED);
+        pthread_join(state->thread, NULL);
+    }
+
+    if(state->filename)
+        free(state->filename);
+    #endif
+
+    if(loader->status == GOBLIN3D_LOAD_RUNNING && state->file)
+        goblin3d_parser_fail(&state->parser);
+
+    goblin3d_load_close(state);
+    free(state);
+    loader->state = NULL;
+}
+
+bool goblin3d_load_publish(goblin3d_loader_t* loader, goblin3d_obj_t* obj) {
+    if(goblin3d_load_status(loader, NULL) != GOBLIN3D_LOAD_DONE)
+        return false;
+    goblin3d_load_release(loader);
+
+    goblin3d_obj_t result = loader->result;
+    result.x_offset = obj->x_offset;
+    result.y_offset = obj->y_offset;
+    result.z_offset = obj->z_offset;
+    result.x_angle_deg = obj->x_angle_deg;
+    result.y_angle_deg = obj->y_angle_deg;
+    result.z_angle_deg = obj->z_angle_deg;
+    result.scale_size = obj->scale_size;
+    result.render_flags = obj->render_flags;
+    result.viewport_width = obj->viewport_width;
+    result.viewport_height = obj->viewport_height;
+
+    goblin3d_free(obj);
+    *obj = result;
+
+    goblin3d_init_empty(&loader->result);
+    goblin3d_load_set(&loader->status, GOBLIN3D_LOAD_IDLE);
+    goblin3d_load_set(&loader->percent, 0);
+
+    return true;
+}
+
+void goblin3d_load_cancel(goblin3d_loader_t* loader) {
+    goblin3d_load_release(loader);
+
+    if(loader->status == GOBLIN3D_LOAD_DONE) {
+        goblin3d_free(&loader->result);
+        goblin3d_init_empty(&loader->result);
+    }
+
+    goblin3d_load_set(&loader->status, GOBLIN3D_LOAD_IDLE);
+    goblin3d_load_set(&loader->percent, 0);
+}
+
+static size_t goblin3d_align8(size_t offset) {
+    return (offset + 7) & ~(size_t) 7;
+}
+
+static bool goblin3d_binary_layout(const goblin3d_binary_header_t* header, size_t* offsets) {
+    if(memcmp(header->magic, GOBLIN3D_BINARY_MAGIC, 4) != 0 ||
+        header->version != GOBLIN3D_BINARY_VERSION)
+        return false;
+
+    bool faces = (header->flags & GOBLIN3D_BINARY_FACES) != 0;
+    bool strips = (header->flags & GOBLIN3D_BINARY_STRIPS) != 0;
+
+    uint64_t sizes[7] = {
+        (uint64_t) header->point_count * ((header->flags & GOBLIN3D_BINARY_QUANTIZED) ?
+            sizeof(uint16_t[3]) : sizeof(float[3])),
+        (uint64_t) header->edge_count * sizeof(uint32_t[2]),
+        faces ? (uint64_t) header->face_count * sizeof(uint32_t[3]) : 0,
+        faces ? (uint64_t) header->face_count * sizeof(uint32_t[3]) : 0,
+        faces ? (uint64_t) header->edge_count : 0,
+        strips ? ((uint64_t) header->strip_count + 1) * sizeof(uint32_t) : 0,
+        strips ? (uint64_t) header->strip_index_count * sizeof(uint32_t) : 0
+    };
+
+    uint64_t offset = goblin3d_align8(sizeof(goblin3d_binary_header_t));
+    for(uint8_t i = 0; i < 7; i++) {
+        offsets[i] = (size_t) offset;
+        offset = goblin3d_align8(offset + sizes[i]);
+
+        if(offset > (size_t) -1)
+            return false;
+    }
+
+    offsets[7] = (size_t) offset;
+    return true;
+}
+
+static void goblin3d_dequantize(const goblin3d_binary_header_t* header, const uint8_t* data,
+    float (*points)[3], uint32_t count) {
+    for(uint32_t i = 0; i < count; i++, data += sizeof(uint16_t[3]))
+        for(uint8_t j = 0; j < 3; j++)
+            points[i][j] = header->quantize_offset[j] +
+                (float) (data[j * 2] | (data[j * 2 + 1] << 8)) * header->quantize_scale[j];
+}
+
+static bool goblin3d_binary_prepare(goblin3d_obj_t* obj, const goblin3d_binary_header_t* header) {
+    goblin3d_init_empty(obj);
+
+    obj->point_count = header->point_count;
+    obj->edge_count = header->edge_count;
+
+    if(header->flags & GOBLIN3D_BINARY_FACES)
+        obj->face_count = header->face_count;
+
+    if(header->flags & GOBLIN3D_BINARY_STRIPS)
+        obj->strip_count = header->strip_count;
+
+    obj->points = (float(*)[2]) malloc(sizeof(float[2]) * (obj->point_count + 1));
+    obj->rotated_points = (float(*)[3]) malloc(sizeof(float[3]) * (obj->point_count + 1));
+
+    if(header->flags & GOBLIN3D_BINARY_FACES) {
+        obj->edge_flags = (uint8_t*) malloc(obj->edge_count + 1);
+        if(!obj->edge_flags)
+            return false;
+    }
+
+    return obj->points && obj->rotated_points;
+}
+
+static bool goblin3d_binary_section(const char* base, size_t offset, size_t size, bool borrow, void** array) {
+    if(borrow) {
+        *array = (void*) (base + offset);
+        return true;
+    }
+
+    *array = malloc(size > 0 ? size : 1);
+    if(!*array)
+        return false;
+
+    memcpy(*array, base + offset, size);
+    return true;
+}
+
+static bool goblin3d_binary_valid(const goblin3d_obj_t* obj, uint32_t strip_index_count) {
+    for(uint32_t i = 0; i < obj->edge_count; i++)
+        if(obj->edges[i][0] >= obj->point_count || obj->edges[i][1] >= obj->point_count)
+            return false;
+
+    for(uint32_t i = 0; i < obj->face_count; i++)
+        for(uint8_t j = 0; j < 3; j++)
+            if(obj->faces[i][j] >= obj->point_count ||
+                (obj->face_edges[i][j] >= obj->edge_count && obj->face_edges[i][j] != GOBLIN3D_NO_EDGE))
+                return false;
+
+    if(obj->strip_count == 0)
+        return true;
+
+    if(obj->strip_offsets[0] != 0 || obj->strip_offsets[obj->strip_count] != strip_index_count)
+        return false;
+
+    for(uint32_t i = 0; i < obj->strip_count; i++)
+        if(obj->strip_offsets[i] > obj->strip_offsets[i + 1])
+            return false;
+
+    for(uint32_t i = 0; i < strip_index_count; i++)
+        if(obj->strip_indices[i] >= obj->point_count)
+            return false;
+
+    return true;
+}
+
+bool goblin3d_load_binary_buffer(const void* data, size_t length, goblin3d_obj_t* obj) {
+    goblin3d_binary_header_t header;
+    size_t offsets[8];
+
+    if(length < sizeof(goblin3d_binary_header_t))
+        return false;
+    memcpy(&header, data, sizeof(goblin3d_binary_header_t));
+
+    if(!goblin3d_binary_layout(&header, offsets) || offsets[7] > length)
+        return false;
+
+    const char* base = (const char*) data;
+    bool borrow = ((uintptr_t) data & 3) == 0;
+    bool loaded = goblin3d_binary_prepare(obj, &header);
+
+    if(loaded && (header.flags & GOBLIN3D_BINARY_QUANTIZED)) {
+        obj->orig_points = (float(*)[3]) malloc(sizeof(float[3]) * (obj->point_count + 1));
+        if(obj->orig_points)
+            goblin3d_dequantize(&header, (const uint8_t*) base + offsets[0], obj->orig_points, obj->point_count);
+        else loaded = false;
+    }
+    else if(loaded) {
+        loaded = goblin3d_binary_section(base, offsets[0], sizeof(float[3]) * obj->point_count,
+            borrow, (void**) &obj->orig_points);
+        obj->borrowed |= borrow ? GOBLIN3D_BORROWED_POINTS : 0;
+    }
+
+    if(loaded) {
+        loaded = goblin3d_binary_section(base, offsets[1], sizeof(uint32_t[2]) * obj->edge_count,
+            borrow, (void**) &obj->edges);
+        obj->borrowed |= borrow ? GOBLIN3D_BORROWED_EDGES : 0;
+    }
+
+    if(loaded && obj->face_count > 0) {
+        loaded = goblin3d_binary_section(base, offsets[2], sizeof(uint32_t[3]) * obj->face_count,
+            borrow, (void**) &obj->faces) &&
+            goblin3d_binary_section(base, offsets[3], sizeof(uint32_t[3]) * obj->face_count,
+            borrow, (void**) &obj->face_edges);
+        obj->borrowed |= borrow ? GOBLIN3D_BORROWED_FACES | GOBLIN3D_BORROWED_FACE_EDGES : 0;
+    }
+
+    if(loaded && obj->edge_flags)
+        memcpy(obj->edge_flags, base + offsets[4], obj->edge_count);
+
+    if(loaded && obj->strip_count > 0) {
+        loaded = goblin3d_binary_section(base, offsets[5], sizeof(uint32_t) * (obj->strip_count + 1),
+            borrow, (void**) &obj->strip_offsets) &&
+            goblin3d_binary_section(base, offsets[6], sizeof(uint32_t) * header.strip_index_count,
+            borrow, (void**) &obj->strip_indices);
+        obj->borrowed |= borrow ? GOBLIN3D_BORROWED_STRIPS : 0;
+    }
+
+    if(loaded)
+        loaded = goblin3d_binary_valid(obj, header.strip_index_count);
+
+    if(!loaded) {
+        goblin3d_free(obj);
+        goblin3d_init_empty(obj);
+    }
+
+    return loaded;
+}
+
+static bool goblin3d_load_binary_stream(goblin3d_obj_t* obj,
+    bool (*read)(void* source, void* data, size_t length), void* source) {
+    goblin3d_binary_header_t header;
+    size_t offsets[8];
+
+    if(!read(source, &header, sizeof(goblin3d_binary_header_t)) ||
+        !goblin3d_binary_layout(&header, offsets))
+        return false;
+
+    bool loaded = goblin3d_binary_prepare(obj, &header);
+    size_t sizes[7] = {
+        sizeof(float[3]) * obj->point_count,
+        sizeof(uint32_t[2]) * obj->edge_count,
+        sizeof(uint32_t[3]) * obj->face_count,
+        sizeof(uint32_t[3]) * obj->face_count,
+        obj->edge_flags ? obj->edge_count : 0,
+        obj->strip_count > 0 ? sizeof(uint32_t) * (obj->strip_count + 1) : 0,
+        obj->strip_count > 0 ? sizeof(uint32_t) * header.strip_index_count : 0
+    };
+
+    void** arrays[7] = {
+        (void**) &obj->orig_points, (void**) &obj->edges,
+        (void**) &obj->faces, (void**) &obj->face_edges, NULL,
+        (void**) &obj->strip_offsets, (void**) &obj->strip_indices
+    };
+
+    size_t position = sizeof(goblin3d_binary_header_t);
+    uint8_t scratch[768];
+
+    for(uint8_t i = 0; loaded && i < 7; i++) {
+        if(sizes[i] == 0 || (i >= 2 && i <= 3 && obj->face_count == 0))
+            continue;
+
+        loaded = read(source, scratch, offsets[i] - position);
+        position = offsets[i];
+
+        void* array = i == 4 ? (void*) obj->edge_flags : malloc(sizes[i]);
+        if(i != 4)
+            *arrays[i] = array;
+
+        if(!loaded || !array) {
+            loaded = false;
+            break;
+        }
+
+        if(i == 0 && (header.flags & GOBLIN3D_BINARY_QUANTIZED)) {
+            uint32_t chunk = sizeof(scratch) / sizeof(uint16_t[3]);
+
+            for(uint32_t j = 0; loaded && j < obj->point_count; j += chunk) {
+                uint32_t count = obj->point_count - j < chunk ? obj->point_count - j : chunk;
+
+                loaded = read(source, scratch, sizeof(uint16_t[3]) * count);
+                goblin3d_dequantize(&header, scratch, obj->orig_points + j, count);
+            }
+
+            position += sizeof(uint16_t[3]) * obj->point_count;
+            continue;
+        }
+
+        loaded = read(source, array, sizes[i]);
+        position += sizes[i];
+    }
+
+    if(loaded)
+        loaded = goblin3d_binary_valid(obj, header.strip_index_count);
+
+    if(!loaded) {
+        goblin3d_free(obj);
+        goblin3d_init_empty(obj);
+    }
+
+    return loaded;
+}
+
+static bool goblin3d_animation_layout(const goblin3d_animation_header_t* header, size_t* size) {
+    if(memcmp(header->magic, GOBLIN3D_ANIMATION_MAGIC, 4) != 0 ||
+        header->version != GOBLIN3D_ANIMATION_VERSION)
+        return false;
+
+    uint64_t bytes = (uint64_t) header->point_count * header->frame_count * sizeof(int16_t[2]);
+    if(bytes > (size_t) -1 - sizeof(goblin3d_animation_header_t))
+        return false;
+
+    *size = (size_t) bytes;
+    return true;
+}
+
+bool goblin3d_load_animation_buffer(const void* data, size_t length, goblin3d_animation_t* animation) {
+    goblin3d_animation_header_t header;
+    size_t size;
+
+    if(length < sizeof(goblin3d_animation_header_t))
+        return false;
+    memcpy(&header, data, sizeof(goblin3d_animation_header_t));
+
+    if(!goblin3d_animation_layout(&header, &size) ||
+        sizeof(goblin3d_animation_header_t) + size > length)
+        return false;
+
+    animation->borrowed = ((uintptr_t) data & 1) == 0;
+    if(!goblin3d_binary_section((const char*) data, sizeof(goblin3d_animation_header_t), size,
+        animation->borrowed, (void**) &animation->points))
+        return false;
+
+    animation->point_count = header.point_count;
+    animation->frame_count = header.frame_count;
+    return true;
+}
+
+static bool goblin3d_load_animation_stream(goblin3d_animation_t* animation,
+    bool (*read)(void* source, void* data, size_t length), void* source) {
+    goblin3d_animation_header_t header;
+    size_t size;
+
+    if(!read(source, &header, sizeof(goblin3d_animation_header_t)) ||
+        !goblin3d_animation_layout(&header, &size))
+        return false;
+
+    animation->points = (int16_t(*)[2]) malloc(size > 0 ? size : 1);
+    if(!animation->points)
+        return false;
+
+    if(!read(source, animation->points, size)) {
+        free(animation->points);
+        animation->points = NULL;
+        return false;
+    }
+
+    animation->point_count = header.point_count;
+    animation->frame_count = header.frame_count;
+    animation->borrowed = false;
+
+    return true;
+}
+
+#ifdef ARDUINO
+
+static bool goblin3d_read_sd(void* source, void* data, size_t length) {
+    return length == 0 || (size_t) ((File*) source)->read((uint8_t*) data, length) == length;
+}
+
+bool goblin3d_load_binary(const char* filename, goblin3d_obj_t* obj) {
+    File file = SD.open(filename);
+    if(!file)
+        return false;
+
+    bool loaded = goblin3d_load_binary_stream(obj, goblin3d_read_sd, &file);
+    file.close();
+
+    return loaded;
+}
+
+bool goblin3d_load_animation(const char* filename, goblin3d_animation_t* animation) {
+    File file = SD.open(filename);
+    if(!file)
+        return false;
+
+    bool loaded = goblin3d_load_animation_stream(animation, goblin3d_read_sd, &file);
+    file.close();
+
+    return loaded;
+}
+
+#else
+
+static bool goblin3d_read_stdio(void* source, void* data, size_t length) {
+    return fread(data, 1, length, (FILE*) source) == length;
+}
+
+bool goblin3d_load_binary(const char* filename, goblin3d_obj_t* obj) {
+    #ifdef GOBLIN3D_POSIX
+    const char* data;
+    size_t size;
+
+    if(goblin3d_map_file(filename, &data, &size)) {
+        bool loaded = goblin3d_load_binary_buffer(data, size, obj);
+
+        if(loaded && obj->borrowed) {
+            obj->mapping = data;
+            obj->mapping_size = size;
+        }
+        else goblin3d_unmap_file(data, size);
+
+        return loaded;
+    }
+    #endif
+
+    FILE* file = fopen(filename, "rb");
+    if(!file)
+        return false;
+
+    bool loaded = goblin3d_load_binary_stream(obj, goblin3d_read_stdio, file);
+    fclose(file);
+
+    return loaded;
+}
+
+bool goblin3d_load_animation(const char* filename, goblin3d_animation_t* animation) {
+    FILE* file = fopen(filename, "rb");
+    if(!file)
+        return false;
+
+    bool loaded = goblin3d_load_animation_stream(animation, goblin3d_read_stdio, file);
+    fclose(file);
+
+    return loaded;
+}
+
+static bool goblin3d_write_section(FILE* file, const void* data, size_t size, size_t* position) {
+    static const uint8_t padding[8] = { 0 };
+    size_t aligned = goblin3d_align8(*position + size);
+
+    if(size > 0 && fwrite(data, 1, size, file) != size)
+        return false;
+
+    if(aligned > *position + size &&
+        fwrite(padding, 1, aligned - *position - size, file) != aligned - *position - size)
+        return false;
+
+    *position = aligned;
+    return true;
+}
+
+bool goblin3d_save_binary(goblin3d_obj_t* obj, const char* filename, uint16_t flags) {
+    goblin3d_binary_header_t header;
+    memset(&header, 0, sizeof(goblin3d_binary_header_t));
+
+    memcpy(header.magic, GOBLIN3D_BINARY_MAGIC, 4);
+    header.version = GOBLIN3D_BINARY_VERSION;
+    header.flags = flags & GOBLIN3D_BINARY_QUANTIZED;
+    header.point_count = obj->point_count;
+    header.edge_count = obj->edge_count;
+
+    if(obj->face_count > 0 && obj->face_edges && obj->edge_flags) {
+        header.flags |= GOBLIN3D_BINARY_FACES;
+        header.face_count = obj->face_count;
+    }
+
+    if(obj->strip_count > 0) {
+        header.flags |= GOBLIN3D_BINARY_STRIPS;
+        header.strip_count = obj->strip_count;
+        header.strip_index_count = obj->strip_offsets[obj->strip_count];
+    }
+
+    if(header.flags & GOBLIN3D_BINARY_QUANTIZED) {
+        goblin3d_update_bounds(obj);
+
+        for(uint8_t i = 0; i < 3; i++) {
+            header.quantize_offset[i] = obj->bound_min[i];
+            header.quantize_scale[i] = (obj->bound_max[i] - obj->bound_min[i]) / 65535.0f;
+        }
+    }
+
+    FILE* file = fopen(filename, "wb");
+    if(!file)
+        return false;
+
+    size_t position = 0;
+    bool written = goblin3d_write_section(file, &header, sizeof(goblin3d_binary_header_t), &position);
+
+    if(written && (header.flags & GOBLIN3D_BINARY_QUANTIZED)) {
+        uint8_t chunk[768];
+        uint32_t count = 0;
+
+        for(uint32_t i = 0; written && i < obj->point_count; i++) {
+            for(uint8_t j = 0; j < 3; j++) {
+                float step = header.quantize_scale[j] > 0.0f ?
+                    (obj->orig_points[i][j] - header.quantize_offset[j]) / header.quantize_scale[j] : 0.0f;
+                uint16_t value = step <= 0.0f ? 0 : (step >= 65535.0f ? 65535 : (uint16_t) (step + 0.5f));
+
+                chunk[count++] = value & 0xFF;
+                chunk[count++] = value >> 8;
+            }
+
+            if(count == sizeof(chunk) || i == obj->point_count - 1) {
+                written = fwrite(chunk, 1, count, file) == count;
+                count = 0;
+            }
+        }
+
+        position += sizeof(uint16_t[3]) * obj->point_count;
+        written = written && goblin3d_write_section(file, NULL, 0, &position);
+    }
+    else written = written && goblin3d_write_section(file, obj->orig_points,
+        sizeof(float[3]) * obj->point_count, &position);
+
+    written = written && goblin3d_write_section(file, obj->edges,
+        sizeof(uint32_t[2]) * obj->edge_count, &position);
+
+    if(header.flags & GOBLIN3D_BINARY_FACES) {
+        uint8_t* edge_flags = (uint8_t*) malloc(obj->edge_count + 1);
+        if(!edge_flags) {
+            fclose(file);
+            return false;
+        }
+
+        for(uint32_t i = 0; i < obj->edge_count; i++)
+            edge_flags[i] = obj->edge_flags[i] & GOBLIN3D_EDGE_HAS_FACE;
+
+        written = written &&
+            goblin3d_write_section(file, obj->faces, sizeof(uint32_t[3]) * obj->face_count, &position) &&
+            goblin3d_write_section(file, obj->face_edges, sizeof(uint32_t[3]) * obj->face_count, &position) &&
+            goblin3d_write_section(file, edge_flags, obj->edge_count, &position);
+        free(edge_flags);
+    }
+
+    if(header.flags & GOBLIN3D_BINARY_STRIPS)
+        written = written &&
+            goblin3d_write_section(file, obj->strip_offsets, sizeof(uint32_t) * (obj->strip_count + 1), &position) &&
+            goblin3d_write_section(file, obj->strip_indices, sizeof(uint32_t) * header.strip_index_count, &position);
+
+    return fclose(file) == 0 && written;
+}
+
+bool goblin3d_save_animation(const goblin3d_animation_t* animation, const char* filename) {
+    goblin3d_animation_header_t header;
+    memset(&header, 0, sizeof(goblin3d_animation_header_t));
+
+    memcpy(header.magic, GOBLIN3D_ANIMATION_MAGIC, 4);
+    header.version = GOBLIN3D_ANIMATION_VERSION;
+    header.point_count = animation->point_count;
+    header.frame_count = animation->frame_count;
+
+    FILE* file = fopen(filename, "wb");
+    if(!file)
+        return false;
+
+    size_t size = sizeof(int16_t[2]) * animation->point_count * (size_t) animation->frame_count;
+    bool written = fwrite(&header, 1, sizeof(goblin3d_animation_header_t), file) == sizeof(goblin3d_animation_header_t) &&
+        (size == 0 || fwrite(animation->points, 1, size, file) == size);
+
+    return fclose(file) == 0 && written;
+}
+
+#endif
+
+#ifdef GOBLIN3D_POSIX
+
+bool goblin3d_stream_open(goblin3d_stream_t* stream, const char* filename, uint32_t window_size) {
+    goblin3d_binary_header_t header;
+    size_t offsets[8];
+
+    memset(stream, 0, sizeof(goblin3d_stream_t));
+    if(!goblin3d_map_file(filename, &stream->mapping, &stream->mapping_size))
+        return false;
+
+    if(stream->mapping_size < sizeof(goblin3d_binary_header_t)) {
+        goblin3d_stream_close(stream);
+        return false;
+    }
+
+    memcpy(&header, stream->mapping, sizeof(goblin3d_binary_header_t));
+    if(!goblin3d_binary_layout(&header, offsets) || offsets[7] > stream->mapping_size) {
+        goblin3d_stream_close(stream);
+        return false;
+    }
+
+    uint32_t slots = 64;
+    while(slots < window_size && slots < 0x80000000u)
+        slots <<= 1;
+
+    stream->window = (float(*)[2]) malloc(sizeof(float[2]) * slots);
+    stream->window_tags = (uint32_t*) malloc(sizeof(uint32_t) * slots);
+
+    if(!stream->window || !stream->window_tags) {
+        goblin3d_stream_close(stream);
+        return false;
+    }
+
+    stream->window_mask = slots - 1;
+    stream->points = (const uint8_t*) stream->mapping + offsets[0];
+    stream->edges = (const uint32_t(*)[2]) (stream->mapping + offsets[1]);
+    stream->point_count = header.point_count;
+    stream->edge_count = header.edge_count;
+    stream->quantized = (header.flags & GOBLIN3D_BINARY_QUANTIZED) != 0;
+
+    for(uint8_t i = 0; i < 3; i++) {
+        stream->quantize_offset[i] = header.quantize_offset[i];
+        stream->quantize_scale[i] = header.quantize_scale[i];
+    }
+
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    size_t edges_start = offsets[1] / page * page;
+    size_t edges_end = offsets[1] + sizeof(uint32_t[2]) * stream->edge_count;
+
+    madvise((void*) stream->mapping, stream->mapping_size, MADV_NORMAL);
+    madvise((void*) (stream->mapping + edges_start), edges_end - edges_start, MADV_SEQUENTIAL);
+
+    return true;
+}
+
+void goblin3d_stream_close(goblin3d_stream_t* stream) {
+    if(stream->mapping)
+        goblin3d_unmap_file(stream->mapping, stream->mapping_size);
+
+    if(stream->window)
+        free(stream->window);
+
+    if(stream->window_tags)
+        free(stream->window_tags);
+
+    stream->mapping = NULL;
+    stream->window = NULL;
+    stream->window_tags = NULL;
+}
+
+static const float* goblin3d_stream_point(goblin3d_stream_t* stream, const goblin3d_rotation_t* rotation,
+    uint32_t index) {
+    uint32_t slot = index & stream->window_mask;
+    float* projected = stream->window[slot];
+
+    if(stream->window_tags[slot] == index)
+        return projected;
+
+    float x, y, z;
+    if(stream->quantized) {
+        const uint8_t* data = stream->points + (size_t) index * sizeof(uint16_t[3]);
+
+        x = stream->quantize_offset[0] + (float) (data[0] | (data[1] << 8)) * stream->quantize_scale[0];
+        y = stream->quantize_offset[1] + (float) (data[2] | (data[3] << 8)) * stream->quantize_scale[1];
+        z = stream->quantize_offset[2] + (float) (data[4] | (data[5] << 8)) * stream->quantize_scale[2];
+    }
+    else {
+        float point[3];
+        memcpy(point, stream->points + (size_t) index * sizeof(float[3]), sizeof(float[3]));
+
+        x = point[0];
+        y = point[1];
+        z = point[2];
+    }
+
+    goblin3d_rotate(rotation, &x, &y, &z);
+
+    float z_clamped = z < -3.0 ? z : -3.0;
+    projected[0] = round(x / z_clamped * stream->scale_size) + stream->x_offset;
+    projected[1] = round(y / z_clamped * stream->scale_size) + stream->y_offset;
+
+    stream->window_tags[slot] = index;
+    return projected;
+}
+
+static void goblin3d_stream_release(const char* mapping, size_t start, size_t end) {
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+
+    start = (start + page - 1) / page * page;
+    end = end / page * page;
+
+    if(end > start)
+        madvise((void*) (mapping + start), end - start, MADV_DONTNEED);
+}
+
+void goblin3d_render_stream(goblin3d_stream_t* stream, goblin3d_obj_draw_fn draw) {
+    goblin3d_rotation_t rotation;
+    goblin3d_rotation_angles(stream->x_angle_deg, stream->y_angle_deg, stream->z_angle_deg, &rotation);
+
+    memset(stream->window_tags, 0xFF, sizeof(uint32_t) * (stream->window_mask + 1));
+
+    size_t point_size = stream->quantized ? sizeof(uint16_t[3]) : sizeof(float[3]);
+    size_t points_offset = (const char*) stream->points - stream->mapping;
+    size_t edges_offset = (const char*) stream->edges - stream->mapping;
+    uint32_t previous = 0;
+    bool sorted = true;
+
+    for(uint32_t chunk = 0; chunk < stream->edge_count; chunk += GOBLIN3D_STREAM_CHUNK) {
+        uint32_t end = stream->edge_count - chunk < GOBLIN3D_STREAM_CHUNK ?
+            stream->edge_count : chunk + GOBLIN3D_STREAM_CHUNK;
+
+        for(uint32_t i = chunk; i < end; i++) {
+            uint32_t start_index = stream->edges[i][0], end_index = stream->edges[i][1];
+            if(start_index >= stream->point_count || end_index >= stream->point_count)
+                continue;
+
+            sorted = sorted && start_index >= previous && start_index < end_index;
+            previous = start_index;
+
+            const float* start = goblin3d_stream_point(stream, &rotation, start_index);
+            uint16_t x1 = start[0], y1 = start[1];
+
+            const float* finish = goblin3d_stream_point(stream, &rotation, end_index);
+            draw(x1, y1, finish[0], finish[1]);
+        }
+
+        goblin3d_stream_release(stream->mapping, edges_offset + sizeof(uint32_t[2]) * chunk,
+            edges_offset + sizeof(uint32_t[2]) * end);
+
+        if(sorted)
+            goblin3d_stream_release(stream->mapping, points_offset,
+                points_offset + point_size * previous);
+    }
+}
+
+#endif
+
+typedef struct {
+    goblin3d_obj_parser_t parser;
+    bool filtering;
+    float feature_cos;
+
+    uint32_t* point_table;
+    uint8_t point_table_bits;
+
+    float (*edge_normals)[3];
+    uint8_t* edge_states;
+    uint32_t edge_normal_capacity;
+    uint32_t edge_state_capacity;
+} goblin3d_stl_loader_t;
+
+static void goblin3d_stl_free(goblin3d_stl_loader_t* loader) {
+    free(loader->point_table);
+    free(loader->edge_normals);
+    free(loader->edge_states);
+
+    loader->point_table = NULL;
+    loader->edge_normals = NULL;
+    loader->edge_states = NULL;
+}
+
+static bool goblin3d_stl_fail(goblin3d_stl_loader_t* loader) {
+    goblin3d_stl_free(loader);
+    return goblin3d_parser_fail(&loader->parser);
+}
+
+static bool goblin3d_stl_rehash(goblin3d_stl_loader_t* loader, uint8_t bits) {
+    goblin3d_obj_t* obj = loader->parser.obj;
+    uint32_t size = (uint32_t) 1 << bits;
+
+    uint32_t* table = (uint32_t*) malloc(sizeof(uint32_t) * size);
+    if(!table)
+        return false;
+    memset(table, 0xFF, sizeof(uint32_t) * size);
+
+    for(uint32_t i = 0; i < obj->point_count; i++) {
+        uint32_t slot = goblin3d_point_hash(obj->orig_points[i], bits);
+        while(table[slot] != GOBLIN3D_NO_EDGE)
+            slot = (slot + 1) & (size - 1);
+
+        table[slot] = i;
+    }
+
+    free(loader->point_table);
+    loader->point_table = table;
+    loader->point_table_bits = bits;
+
+    return true;
+}
+
+static bool goblin3d_stl_init(goblin3d_stl_loader_t* loader, goblin3d_obj_t* obj,
+    uint32_t triangle_count, float feature_angle, uint8_t flags) {
+    memset(loader, 0, sizeof(goblin3d_stl_loader_t));
+    goblin3d_parser_init(&loader->parser, obj, flags & GOBLIN3D_PARSE_KEEP_FACES);
+
+    loader->filtering = feature_angle > 0.0f;
+    loader->feature_cos = cos(feature_angle * M_PI / 180.0);
+
+    uint8_t point_bits = 10, edge_bits = 10;
+    while(point_bits < 30 && ((uint64_t) 1 << point_bits) < triangle_count)
+        point_bits++;
+
+    while(edge_bits < 30 && ((uint64_t) 1 << edge_bits) < (uint64_t) triangle_count * 3)
+        edge_bits++;
+
+    return goblin3d_stl_rehash(loader, point_bits) &&
+        goblin3d_parser_rehash(&loader->parser, edge_bits);
+}
+
+static bool goblin3d_stl_point(goblin3d_stl_loader_t* loader, const float* point, uint32_t* index) {
+    goblin3d_obj_t* obj = loader->parser.obj;
+
+    if(!loader->point_table || (uint64_t) obj->point_count * 2 >= ((uint64_t) 1 << loader->point_table_bits))
+        if(!goblin3d_stl_rehash(loader, loader->point_table ? loader->point_table_bits + 1 : 10))
+            return false;
+
+    uint32_t mask = ((uint32_t) 1 << loader->point_table_bits) - 1;
+    uint32_t slot = goblin3d_point_hash(point, loader->point_table_bits);
+
+    for(; loader->point_table[slot] != GOBLIN3D_NO_EDGE; slot = (slot + 1) & mask) {
+        const float* existing = obj->orig_points[loader->point_table[slot]];
+
+        if(existing[0] == point[0] && existing[1] == point[1] && existing[2] == point[2]) {
+            *index = loader->point_table[slot];
+            return true;
+        }
+    }
+
+    if(!goblin3d_parser_point(&loader->parser, point[0], point[1], point[2]))
+        return false;
+
+    *index = obj->point_count - 1;
+    loader->point_table[slot] = *index;
+
+    return true;
+}
+
+static bool goblin3d_stl_edge(goblin3d_stl_loader_t* loader, uint32_t v1, uint32_t v2,
+    const float* normal, uint32_t* edge) {
+    goblin3d_obj_t* obj = loader->parser.obj;
+    uint32_t edge_count = obj->edge_count;
+
+    if(!goblin3d_parser_edge(&loader->parser, v1, v2, edge))
+        return false;
+
+    if(!loader->filtering)
+        return true;
+
+    if(obj->edge_count > edge_count) {
+        if(!goblin3d_reserve((void**) &loader->edge_normals, &loader->edge_normal_capacity,
+                *edge, sizeof(float[3])) ||
+            !goblin3d_reserve((void**) &loader->edge_states, &loader->edge_state_capacity,
+                *edge, sizeof(uint8_t)))
+            return false;
+
+        memcpy(loader->edge_normals[*edge], normal, sizeof(float[3]));
+        loader->edge_states[*edge] = GOBLIN3D_STL_EDGE_BORDER;
+    }
+    else if(loader->edge_states[*edge] == GOBLIN3D_STL_EDGE_BORDER) {
+        const float* first = loader->edge_normals[*edge];
+        float cosine = first[0] * normal[0] + first[1] * normal[1] + first[2] * normal[2];
+
+        loader->edge_states[*edge] = cosine < loader->feature_cos ?
+            GOBLIN3D_STL_EDGE_FEATURE : GOBLIN3D_STL_EDGE_SMOOTH;
+    }
+    else loader->edge_states[*edge] = GOBLIN3D_STL_EDGE_FEATURE;
+
+    return true;
+}
+
+static bool goblin3d_stl_records(goblin3d_stl_loader_t* loader, const uint8_t* records, uint32_t count) {
+    for(uint32_t i = 0; i < count; i++) {
+        float corners[3][3];
+        memcpy(corners, records + i * 50 + 12, sizeof(corners));
+
+        for(uint8_t j = 0; j < 3; j++)
+            for(uint8_t k = 0; k < 3; k++)
+                corners[j][k] += 0.0f;
+
+        float u[3], v[3];
+        for(uint8_t k = 0; k < 3; k++) {
+            u[k] = corners[1][k] - corners[0][k];
+            v[k] = corners[2][k] - corners[0][k];
+        }
+
+        float normal[3] = {
+            u[1] * v[2] - u[2] * v[1],
+            u[2] * v[0] - u[0] * v[2],
+            u[0] * v[1] - u[1] * v[0]
+        };
+
+        float length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if(!(length > 0.0f))
+            continue;
+
+        for(uint8_t k = 0; k < 3; k++)
+            normal[k] /= length;
+
+        uint32_t a, b, c, ab, bc, ca;
+        if(!goblin3d_stl_point(loader, corners[0], &a) ||
+            !goblin3d_stl_point(loader, corners[1], &b) ||
+            !goblin3d_stl_point(loader, corners[2], &c))
+            return false;
+
+        if(!goblin3d_stl_edge(loader, a, b, normal, &ab) ||
+            !goblin3d_stl_edge(loader, b, c, normal, &bc) ||
+            !goblin3d_stl_edge(loader, c, a, normal, &ca))
+            return false;
+
+        if((loader->parser.flags & GOBLIN3D_PARSE_KEEP_FACES) &&
+            !goblin3d_parser_face(&loader->parser, a, b, c, ab, bc, ca))
+            return false;
+    }
+
+    return true;
+}
+
+static bool goblin3d_stl_filter(goblin3d_stl_loader_t* loader) {
+    goblin3d_obj_t* obj = loader->parser.obj;
+    uint32_t count = obj->point_count > obj->edge_count ? obj->point_count : obj->edge_count;
+
+    uint32_t* remap = (uint32_t*) malloc(sizeof(uint32_t) * (count + 1));
+    if(!remap)
+        return false;
+
+    uint32_t kept = 0;
+    for(uint32_t i = 0; i < obj->edge_count; i++) {
+        if(loader->edge_states[i] == GOBLIN3D_STL_EDGE_SMOOTH) {
+            remap[i] = GOBLIN3D_NO_EDGE;
+            continue;
+        }
+
+        obj->edges[kept][0] = obj->edges[i][0];
+        obj->edges[kept][1] = obj->edges[i][1];
+
+        if(obj->edge_flags)
+            obj->edge_flags[kept] = obj->edge_flags[i];
+        remap[i] = kept++;
+    }
+
+    for(uint32_t i = 0; i < obj->face_count; i++)
+        for(uint8_t j = 0; j < 3; j++)
+            if(obj->face_edges[i][j] != GOBLIN3D_NO_EDGE)
+                obj->face_edges[i][j] = remap[obj->face_edges[i][j]];
+    obj->edge_count = kept;
+
+    if(obj->face_count == 0) {
+        for(uint32_t i = 0; i < obj->point_count; i++)
+            remap[i] = GOBLIN3D_NO_EDGE;
+
+        for(uint32_t i = 0; i < obj->edge_count; i++)
+            for(uint8_t j = 0; j < 2; j++)
+                remap[obj->edges[i][j]] = 0;
+
+        kept = 0;
+        for(uint32_t i = 0; i < obj->point_count; i++) {
+            if(remap[i] == GOBLIN3D_NO_EDGE)
+                continue;
+
+            memmove(obj->orig_points[kept], obj->orig_points[i], sizeof(float[3]));
+            remap[i] = kept++;
+        }
+
+        for(uint32_t i = 0; i < obj->edge_count; i++)
+            for(uint8_t j = 0; j < 2; j++)
+                obj->edges[i][j] = remap[obj->edges[i][j]];
+        obj->point_count = kept;
+    }
+
+    free(remap);
+    return true;
+}
+
+static bool goblin3d_stl_finish(goblin3d_stl_loader_t* loader) {
+    if(loader->filtering && !goblin3d_stl_filter(loader))
+        return false;
+
+    goblin3d_stl_free(loader);
+    return goblin3d_parser_finish(&loader->parser);
+}
+
+bool goblin3d_parse_stl_buffer(const void* data, size_t length, goblin3d_obj_t* obj,
+    float feature_angle, uint8_t flags) {
+    const uint8_t* bytes = (const uint8_t*) data;
+    uint32_t triangle_count;
+
+    if(length < 84)
+        return false;
+
+    memcpy(&triangle_count, bytes + 80, sizeof(uint32_t));
+    if((length - 84) / 50 < triangle_count)
+        return false;
+
+    goblin3d_stl_loader_t loader;
+    if(!goblin3d_stl_init(&loader, obj, triangle_count, feature_angle, flags) ||
+        !goblin3d_stl_records(&loader, bytes + 84, triangle_count) || !goblin3d_stl_finish(&loader))
+        return goblin3d_stl_fail(&loader);
+
+    return true;
+}
+
+static bool goblin3d_parse_stl_stream(goblin3d_obj_t* obj, float feature_angle, uint8_t flags,
+    bool (*read)(void* source, void* data, size_t length), void* source, size_t length,
+    uint8_t* block, uint32_t block_records) {
+    uint32_t triangle_count;
+
+    if(length < 84 || !read(source, block, 84))
+        return false;
+
+    memcpy(&triangle_count, block + 80, sizeof(uint32_t));
+    if((length - 84) / 50 < triangle_count)
+        return false;
+
+    goblin3d_stl_loader_t loader;
+    if(!goblin3d_stl_init(&loader, obj, triangle_count, feature_angle, flags))
+        return goblin3d_stl_fail(&loader);
+
+    for(uint32_t i = 0; i < triangle_count; i += block_records) {
+        uint32_t count = triangle_count - i < block_records ? triangle_count - i : block_records;
+
+        if(!read(source, block, (size_t) count * 50) || !goblin3d_stl_records(&loader, block, count))
+            return goblin3d_stl_fail(&loader);
+    }
+
+    if(!goblin3d_stl_finish(&loader))
+        return goblin3d_stl_fail(&loader);
+
+    return true;
+}
+
+bool goblin3d_parse_stl_file(const char* filename, goblin3d_obj_t* obj, float feature_angle, uint8_t flags) {
+    #ifdef ARDUINO
+    static uint8_t block[GOBLIN3D_PARSE_BLOCK_SIZE / 50 * 50];
+
+    File file = SD.open(filename);
+    if(!file)
+        return false;
+
+    bool parsed = goblin3d_parse_stl_stream(obj, feature_angle, flags,
+        goblin3d_read_sd, &file, file.size(), block, sizeof(block) / 50);
+    file.close();
+
+    return parsed;
+
+    #else
+
+    #ifdef GOBLIN3D_POSIX
+    const char* data;
+    size_t size;
+
+    if(goblin3d_map_file(filename, &data, &size)) {
+        bool parsed = goblin3d_parse_stl_buffer(data, size, obj, feature_angle, flags);
+        goblin3d_unmap_file(data, size);
+
+        return parsed;
+    }
+    #endif
+
+    FILE* file = fopen(filename, "rb");
+    if(!file)
+        return false;
+
+    long length = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+    uint8_t* block = (uint8_t*) malloc(GOBLIN3D_PARSE_BLOCK_SIZE / 50 * 50);
+
+    if(length < 0 || fseek(file, 0, SEEK_SET) != 0 || !block) {
+        free(block);
+        fclose(file);
+        return false;
+    }
+
+    bool parsed = goblin3d_parse_stl_stream(obj, feature_angle, flags,
+        goblin3d_read_stdio, file, (size_t) length, block, GOBLIN3D_PARSE_BLOCK_SIZE / 50);
+
+    free(block);
+    fclose(file);
+
+    return parsed;
+
+    #endif
+}
+
+typedef struct {
+    uint8_t type;
+    uint8_t count_type;
+    uint8_t role;
+} goblin3d_ply_property_t;
+
+typedef struct {
+    uint32_t count;
+    uint8_t kind;
+    uint8_t property_count;
+    goblin3d_ply_property_t properties[GOBLIN3D_PLY_MAX_PROPERTIES];
+} goblin3d_ply_element_t;
+
+typedef struct {
+    const uint8_t* data;
+    size_t length;
+    size_t position;
+
+    bool (*read)(void* source, void* data, size_t length);
+    void* source;
+    uint8_t* block;
+    size_t block_size;
+} goblin3d_ply_reader_t;
+
+static const char* goblin3d_ply_type_names[] = {
+    "char", "uchar", "short", "ushort", "int", "uint", "float", "double",
+    "int8", "uint8", "int16", "uint16", "int32", "uint32", "float32", "float64"
+};
+
+static const uint8_t goblin3d_ply_type_sizes[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
+
+static uint8_t goblin3d_ply_type(const char* name) {
+    for(uint8_t i = 0; i < 16; i++)
+        if(strcmp(name, goblin3d_ply_type_names[i]) == 0)
+            return (i % 8) + 1;
+
+    return 0;
+}
+
+static double goblin3d_ply_value(const uint8_t* data, uint8_t type) {
+    int8_t int8;
+    int16_t int16;
+    uint16_t uint16;
+    int32_t int32;
+    uint32_t uint32;
+    float float32;
+    double float64;
+
+    switch(type) {
+        case 1: memcpy(&int8, data, 1); return int8;
+        case 2: return *data;
+        case 3: memcpy(&int16, data, 2); return int16;
+        case 4: memcpy(&uint16, data, 2); return uint16;
+        case 5: memcpy(&int32, data, 4); return int32;
+        case 6: memcpy(&uint32, data, 4); return uint32;
+        case GOBLIN3D_PLY_FLOAT32: memcpy(&float32, data, 4); return float32;
+        default: memcpy(&float64, data, 8); return float64;
+    }
+}
+
+static const uint8_t* goblin3d_ply_fetch(goblin3d_ply_reader_t* reader, size_t length) {
+    if(reader->read) {
+        if(length > reader->block_size || !reader->read(reader->source, reader->block, length))
+            return NULL;
+
+        return reader->block;
+    }
+
+    if(reader->length - reader->position < length)
+        return NULL;
+
+    const uint8_t* data = reader->data + reader->position;
+    reader->position += length;
+
+    return data;
+}
+
+static bool goblin3d_ply_line(goblin3d_ply_reader_t* reader, char* line, size_t size) {
+    size_t length = 0;
+    const uint8_t* byte;
+
+    while((byte = goblin3d_ply_fetch(reader, 1)) != NULL && *byte != '\n')
+        if(*byte != '\r' && length < size - 1)
+            line[length++] = *byte;
+
+    line[length] = '\0';
+    return byte != NULL;
+}
+
+static bool goblin3d_ply_header(goblin3d_ply_reader_t* reader, goblin3d_ply_element_t* elements, uint8_t* element_count) {
+    char line[128], type[16], count_type[16], name[32];
+    unsigned long count;
+
+    if(!goblin3d_ply_line(reader, line, sizeof(line)) || strcmp(line, "ply") != 0)
+        return false;
+
+    *element_count = 0;
+    while(goblin3d_ply_line(reader, line, sizeof(line))) {
+        goblin3d_ply_element_t* element = *element_count > 0 ? &elements[*element_count - 1] : NULL;
+
+        if(strcmp(line, "end_header") == 0)
+            return true;
+
+        if(strncmp(line, "format ", 7) == 0) {
+            if(strncmp(line + 7, "binary_little_endian ", 21) != 0)
+                return false;
+        }
+        else if(sscanf(line, "element %31s %lu", name, &count) == 2) {
+            if(*element_count == GOBLIN3D_PLY_MAX_ELEMENTS)
+                return false;
+
+            element = &elements[(*element_count)++];
+            element->count = (uint32_t) count;
+            element->property_count = 0;
+            element->kind = strcmp(name, "vertex") == 0 ? GOBLIN3D_PLY_VERTEX :
+                (strcmp(name, "face") == 0 ? GOBLIN3D_PLY_FACE : GOBLIN3D_PLY_OTHER);
+        }
+        else if(strncmp(line, "property ", 9) == 0) {
+            if(!element || element->property_count == GOBLIN3D_PLY_MAX_PROPERTIES)
+                return false;
+
+            goblin3d_ply_property_t* property = &element->properties[element->property_count++];
+            property->count_type = 0;
+            property->role = 0;
+
+            if(sscanf(line, "property list %15s %15s %31s", count_type, type, name) == 3) {
+                property->count_type = goblin3d_ply_type(count_type);
+                property->type = goblin3d_ply_type(type);
+
+                if(property->count_type == 0 || property->count_type >= GOBLIN3D_PLY_FLOAT32)
+                    return false;
+
+                if(element->kind == GOBLIN3D_PLY_FACE &&
+                    (strcmp(name, "vertex_indices") == 0 || strcmp(name, "vertex_index") == 0))
+                    property->role = GOBLIN3D_PLY_ROLE_INDICES;
+            }
+            else if(sscanf(line, "property %15s %31s", type, name) == 2) {
+                property->type = goblin3d_ply_type(type);
+
+                if(element->kind == GOBLIN3D_PLY_VERTEX && name[0] >= 'x' && name[0] <= 'z' && name[1] == '\0')
+                    property->role = GOBLIN3D_PLY_ROLE_X + (name[0] - 'x');
+            }
+
+            if(property->type == 0)
+                return false;
+        }
+    }
+
+    return false;
+}
+
+static bool goblin3d_ply_vertices(goblin3d_ply_reader_t* reader, const goblin3d_ply_element_t* element,
+    goblin3d_obj_parser_t* parser) {
+    goblin3d_obj_t* obj = parser->obj;
+    size_t offsets[3] = { 0, 0, 0 }, stride = 0;
+    uint8_t types[3] = { 0, 0, 0 };
+
+    for(uint8_t i = 0; i < element->property_count; i++) {
+        const goblin3d_ply_property_t* property = &element->properties[i];
+        if(property->count_type != 0)
+            return false;
+
+        if(property->role != 0) {
+            offsets[property->role - GOBLIN3D_PLY_ROLE_X] = stride;
+            types[property->role - GOBLIN3D_PLY_ROLE_X] = property->type;
+        }
+
+        stride += goblin3d_ply_type_sizes[property->type];
+    }
+
+    if(types[0] == 0 || types[1] == 0 || types[2] == 0 || element->count > SIZE_MAX / stride)
+        return false;
+
+    obj->orig_points = (float(*)[3]) malloc(sizeof(float[3]) * ((size_t) element->count + 1));
+    if(!obj->orig_points)
+        return false;
+
+    obj->point_count = element->count;
+    parser->point_capacity = element->count;
+
+    uint32_t chunk = reader->read ? (uint32_t) (reader->block_size / stride) : element->count;
+    if(chunk == 0)
+        return element->count == 0;
+
+    bool packed = stride == sizeof(float[3]) && offsets[0] == 0 && offsets[1] == 4 && offsets[2] == 8 &&
+        types[0] == GOBLIN3D_PLY_FLOAT32 && types[1] == GOBLIN3D_PLY_FLOAT32 && types[2] == GOBLIN3D_PLY_FLOAT32;
+
+    for(uint32_t first = 0; first < element->count; first += chunk) {
+        uint32_t count = element->count - first < chunk ? element->count - first : chunk;
+        float (*points)[3] = obj->orig_points + first;
+
+        const uint8_t* records = goblin3d_ply_fetch(reader, stride * count);
+        if(!records)
+            return false;
+
+        if(packed) {
+            memcpy(points, records, sizeof(float[3]) * count);
+            continue;
+        }
+
+        for(uint8_t j = 0; j < 3; j++) {
+            const uint8_t* cursor = records + offsets[j];
+
+            if(types[j] == GOBLIN3D_PLY_FLOAT32)
+                for(uint32_t i = 0; i < count; i++, cursor += stride)
+                    memcpy(&points[i][j], cursor, sizeof(float));
+            else for(uint32_t i = 0; i < count; i++, cursor += stride)
+                points[i][j] = (float) goblin3d_ply_value(cursor, types[j]);
+        }
+    }
+
+    return true;
+}
+
+static bool goblin3d_ply_records(goblin3d_ply_reader_t* reader, const goblin3d_ply_element_t* element,
+    goblin3d_obj_parser_t* parser, uint32_t vertex_count) {
+    size_t stride = 0;
+    bool fixed = true;
+
+    for(uint8_t i = 0; i < element->property_count; i++) {
+        fixed = fixed && element->properties[i].count_type == 0;
+        stride += goblin3d_ply_type_sizes[element->properties[i].type];
+    }
+
+    if(fixed) {
+        uint32_t chunk = reader->read ? (uint32_t) (reader->block_size / (stride > 0 ? stride : 1)) : element->count;
+
+        for(uint32_t first = 0; chunk > 0 && first < element->count; first += chunk) {
+            uint32_t count = element->count - first < chunk ? element->count - first : chunk;
+            if(!goblin3d_ply_fetch(reader, stride * count))
+                return false;
+        }
+
+        return stride == 0 || chunk > 0;
+    }
+
+    for(uint32_t i = 0; i < element->count; i++)
+        for(uint8_t j = 0; j < element->property_count; j++) {
+            const goblin3d_ply_property_t* property = &element->properties[j];
+            uint8_t size = goblin3d_ply_type_sizes[property->type];
+
+            if(property->count_type == 0) {
+                if(!goblin3d_ply_fetch(reader, size))
+                    return false;
+                continue;
+            }
+
+            const uint8_t* data = goblin3d_ply_fetch(reader, goblin3d_ply_type_sizes[property->count_type]);
+            if(!data)
+                return false;
+
+            double length = goblin3d_ply_value(data, property->count_type);
+            if(length < 0.0 || !(data = goblin3d_ply_fetch(reader, (size_t) length * size)))
+                return false;
+
+            uint32_t count = (uint32_t) length;
+            if(property->role != GOBLIN3D_PLY_ROLE_INDICES || count < 2)
+                continue;
+
+            while(count > parser->index_capacity)
+                if(!goblin3d_reserve((void**) &parser->indices, &parser->index_capacity,
+                    parser->index_capacity, sizeof(uint32_t)))
+                    return false;
+
+            bool valid = true;
+            for(uint32_t k = 0; k < count; k++, data += size) {
+                double index = goblin3d_ply_value(data, property->type);
+
+                valid = valid && index >= 0.0 && index < vertex_count;
+                parser->indices[k] = valid ? (uint32_t) index : 0;
+            }
+
+            if(!valid && !parser->counting)
+                parser->obj->dropped_count++;
+
+            if(valid && !goblin3d_parser_polygon(parser, count, true))
+                return false;
+        }
+
+    return true;
+}
+
+static bool goblin3d_parse_ply(goblin3d_ply_reader_t* reader, goblin3d_obj_t* obj, uint8_t flags) {
+    goblin3d_ply_element_t elements[GOBLIN3D_PLY_MAX_ELEMENTS];
+    uint8_t element_count;
+
+    if(!goblin3d_ply_header(reader, elements, &element_count))
+        return false;
+
+    uint32_t vertex_count = 0;
+    for(uint8_t i = 0; i < element_count; i++)
+        if(elements[i].kind == GOBLIN3D_PLY_VERTEX)
+            vertex_count = elements[i].count;
+
+    goblin3d_obj_parser_t parser;
+    goblin3d_parser_init(&parser, obj, flags & (GOBLIN3D_PARSE_KEEP_FACES | GOBLIN3D_PARSE_WELD));
+
+    bool parsed = true;
+    for(uint8_t i = 0; parsed && i < element_count; i++)
+        parsed = elements[i].kind == GOBLIN3D_PLY_VERTEX && !obj->orig_points ?
+            goblin3d_ply_vertices(reader, &elements[i], &parser) :
+            goblin3d_ply_records(reader, &elements[i], &parser, vertex_count);
+
+    if(!parsed || !goblin3d_parser_finish(&parser))
+        return goblin3d_parser_fail(&parser);
+
+    return true;
+}
+
+bool goblin3d_parse_ply_buffer(const void* data, size_t length, goblin3d_obj_t* obj, uint8_t flags) {
+    goblin3d_ply_reader_t reader;
+    memset(&reader, 0, sizeof(goblin3d_ply_reader_t));
+
+    reader.data = (const uint8_t*) data;
+    reader.length = length;
+
+    return goblin3d_parse_ply(&reader, obj, flags);
+}
+
+bool goblin3d_parse_ply_file(const char* filename, goblin3d_obj_t* obj, uint8_t flags) {
+    goblin3d_ply_reader_t reader;
+    memset(&reader, 0, sizeof(goblin3d_ply_reader_t));
+
+    #ifdef ARDUINO
+    static uint8_t block[GOBLIN3D_PARSE_BLOCK_SIZE];
+
+    File file = SD.open(filename);
+    if(!file)
+        return false;
+
+    reader.read = goblin3d_read_sd;
+    reader.source = &file;
+    reader.block = block;
+    reader.block_size = sizeof(block);
+
+    bool parsed = goblin3d_parse_ply(&reader, obj, flags);
+    file.close();
+
+    return parsed;
+
+    #else
+
+    #ifdef GOBLIN3D_POSIX
+    const char* data;
+    size_t size;
+
+    if(goblin3d_map_file(filename, &data, &size)) {
+        bool parsed = goblin3d_parse_ply_buffer(data, size, obj, flags);
+        goblin3d_unmap_file(data, size);
+
+        return parsed;
+    }
+    #endif
+
+    FILE* file = fopen(filename, "rb");
+    if(!file)
+        return false;
+
+    reader.read = goblin3d_read_stdio;
+    reader.source = file;
+    reader.block = (uint8_t*) malloc(GOBLIN3D_PARSE_BLOCK_SIZE);
+    reader.block_size = GOBLIN3D_PARSE_BLOCK_SIZE;
+
+    bool parsed = reader.block && goblin3d_parse_ply(&reader, obj, flags);
+
+    free(reader.block);
+    fclose(file);
+
+    return parsed;
+
+    #endif
+}
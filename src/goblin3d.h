@@ -55,13 +55,270 @@
  * 
  * @note The library does not handle memory management for the content of the arrays used for points and edges. 
  * The user is responsible for providing valid data and ensuring that resources are correctly freed using `goblin3d_free`.
+ * 
+ * Points, edges and faces are each stored in a single contiguous block, so `obj.orig_points[i][j]`
+ * and `obj.edges[i][j]` index them as two-dimensional arrays.
  */
 #ifndef GOBLIN3D_H
 #define GOBLIN3D_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+/**
+ * @brief Defined on desktop POSIX hosts, where threaded and file-mapping features are available.
+ */
+#   define GOBLIN3D_POSIX
+#   include <pthread.h>
+#endif
+
+/**
+ * @brief Maximum number of points handed to a polyline callback at once.
+ *
+ * Longer strips are split into several calls that share their boundary point.
+ */
+#define GOBLIN3D_STRIP_BATCH            64
+
+/**
+ * @brief Maximum number of points handed to a point plotting callback at once.
+ */
+#define GOBLIN3D_POINT_BATCH            64
+
+/**
+ * @brief Width and height, in pixels, of the screen tiles used by the tiled renderer.
+ */
+#define GOBLIN3D_TILE_SIZE              64
+
+/**
+ * @brief Number of edges read per chunk by the streaming renderer.
+ *
+ * Once a chunk has been drawn, its pages are released from the process, so the
+ * resident part of the edge section never grows beyond about one chunk.
+ */
+#define GOBLIN3D_STREAM_CHUNK           16384
+
+/**
+ * @brief Sentinel stored in `face_edges` for triangle sides that have no matching edge.
+ *
+ * Polygons with more than three corners are split into a triangle fan, and the
+ * interior diagonals of that fan are not part of the wireframe. Those triangle
+ * sides are marked with this value instead of an edge index.
+ */
+#define GOBLIN3D_NO_EDGE                0xFFFFFFFFu
+
+/**
+ * @brief Render flag enabling back-face culling in `goblin3d_render`.
+ *
+ * When set in `render_flags` and the object has retained faces, only edges that
+ * belong to at least one front-facing triangle (or to no triangle at all) are drawn.
+ */
+#define GOBLIN3D_RENDER_CULL_BACKFACES  0x01
+
+/**
+ * @brief Render flag enabling level-of-detail selection in `goblin3d_precalculate`.
+ *
+ * When set in `render_flags` and the object has levels built by `goblin3d_build_lods`,
+ * a coarser edge set is picked from the projected bounding radius every frame.
+ * Only the points of the selected level are transformed, and the level applies to
+ * `goblin3d_render` and the point renderers. Other render functions draw the full
+ * mesh and transform the remaining points themselves when a level is selected, so
+ * they gain nothing from it. Levels have no faces, so no level is selected while
+ * `GOBLIN3D_RENDER_CULL_BACKFACES` applies to the object. Adding points or edges
+ * discards the levels.
+ */
+#define GOBLIN3D_RENDER_LOD             0x02
+
+/**
+ * @brief Relative margin around each level-of-detail threshold.
+ *
+ * A coarser level is only selected once the projected radius falls this fraction
+ * below its threshold, and left once it rises this fraction above it, so objects
+ * hovering around a threshold do not flicker between levels.
+ */
+#define GOBLIN3D_LOD_HYSTERESIS         0.1
+
+/**
+ * @brief Parse flag requesting that face topology be retained in the object.
+ *
+ * Without this flag, faces read from an OBJ file are only turned into edges.
+ */
+#define GOBLIN3D_PARSE_KEEP_FACES       0x01
+
+/**
+ * @brief Parse flag requesting that the file be memory-mapped instead of read.
+ *
+ * On POSIX hosts the whole file is mapped read-only and tokenized directly from
+ * the mapping, which is advised for sequential access. When the file cannot be
+ * mapped, or on other platforms, parsing falls back to buffered block reads.
+ */
+#define GOBLIN3D_PARSE_MMAP             0x02
+
+/**
+ * @brief Parse flag requesting that every array be allocated at its exact final size.
+ *
+ * The input is tokenized twice: a first pass only counts points, unique edges and
+ * triangles, then every array is allocated once and filled by a second pass without
+ * any reallocation. Peak memory during loading then stays close to the size of the
+ * loaded object, at the cost of reading the input twice, which is cheap from a
+ * memory mapping and worthwhile on boards with little RAM.
+ */
+#define GOBLIN3D_PARSE_EXACT            0x04
+
+/**
+ * @brief Parse flag requesting that the parsed mesh be cached next to the OBJ file.
+ *
+ * On POSIX hosts the parsed object is saved as a binary mesh in a sidecar file named
+ * after the OBJ file with `GOBLIN3D_CACHE_SUFFIX` appended, tagged with the source's
+ * size, modification time and content hash. Later loads of an unchanged file map the
+ * cache instead of parsing any text. A stale or unreadable cache is rebuilt, and a
+ * cache that cannot be written is skipped silently. The flag has no effect on
+ * other platforms.
+ */
+#define GOBLIN3D_PARSE_CACHE            0x08
+
+/**
+ * @brief Parse flag requesting that points at identical positions be merged.
+ *
+ * Exporters often write one copy of a position per face corner to split normals or
+ * texture seams. With this flag, `goblin3d_weld` is run with an epsilon of 0 once
+ * parsing completes, so each position is transformed only once and edges along
+ * seams are drawn only once.
+ */
+#define GOBLIN3D_PARSE_WELD             0x10
+
+/**
+ * @brief Suffix appended to an OBJ file name to name its parse cache.
+ */
+#define GOBLIN3D_CACHE_SUFFIX           ".g3dcache"
+
+/**
+ * @brief Status of a loader that holds no load, either not started or already published.
+ */
+#define GOBLIN3D_LOAD_IDLE              0
+
+/**
+ * @brief Status of a loader whose file is still being parsed.
+ */
+#define GOBLIN3D_LOAD_RUNNING           1
+
+/**
+ * @brief Status of a loader whose object is complete and ready to be published.
+ */
+#define GOBLIN3D_LOAD_DONE              2
+
+/**
+ * @brief Status of a loader whose file could not be read or parsed.
+ */
+#define GOBLIN3D_LOAD_FAILED            3
+
+/**
+ * @brief Size, in bytes, of the blocks read from a file while parsing it.
+ *
+ * Lines may span block boundaries; the unfinished part of a line is carried over
+ * to the next block. On Arduino, blocks are read from the SD card into a static
+ * buffer of this size, a few SD sectors long so each read is a single multi-sector
+ * transfer.
+ */
+#ifdef ARDUINO
+#   define GOBLIN3D_PARSE_BLOCK_SIZE    2048
+#else
+#   define GOBLIN3D_PARSE_BLOCK_SIZE    65536
+#endif
+
+/**
+ * @brief Magic bytes opening every Goblin3D binary mesh file.
+ */
+#define GOBLIN3D_BINARY_MAGIC           "GB3D"
+
+/**
+ * @brief Version of the binary mesh format written by `goblin3d_save_binary`.
+ */
+#define GOBLIN3D_BINARY_VERSION         1
+
+/**
+ * @brief Binary mesh flag marking points stored as 16-bit quantized coordinates.
+ *
+ * Each coordinate is stored as an unsigned 16-bit step between the minimum and maximum
+ * of the object's bounding box, halving the size of the points at the cost of
+ * decoding them while loading.
+ */
+#define GOBLIN3D_BINARY_QUANTIZED       0x01
+
+/**
+ * @brief Binary mesh flag marking that triangles, their edges and edge flags are stored.
+ */
+#define GOBLIN3D_BINARY_FACES           0x02
+
+/**
+ * @brief Binary mesh flag marking that edge strips are stored.
+ */
+#define GOBLIN3D_BINARY_STRIPS          0x04
+
+/**
+ * @brief Magic bytes opening every Goblin3D baked animation file.
+ */
+#define GOBLIN3D_ANIMATION_MAGIC        "G3DA"
+
+/**
+ * @brief Version of the baked animation format written by `goblin3d_save_animation`.
+ */
+#define GOBLIN3D_ANIMATION_VERSION      1
+
+/**
+ * @brief Header of a Goblin3D baked animation.
+ * 
+ * All values are little-endian. The header is followed by `frame_count` frames of
+ * `point_count` projected points, each stored as two signed 16-bit X and Y values,
+ * exactly as in `goblin3d_animation_t`.
+ */
+typedef struct {
+    char magic[4];               /**< `GOBLIN3D_ANIMATION_MAGIC`, without a terminating null. */
+    uint16_t version;            /**< Format version, `GOBLIN3D_ANIMATION_VERSION`. */
+    uint16_t reserved;           /**< Reserved, written as zero. */
+    uint32_t point_count;        /**< The number of points per frame. */
+    uint32_t frame_count;        /**< The number of frames. */
+} goblin3d_animation_header_t;
+
+/**
+ * @brief Header of a Goblin3D binary mesh.
+ * 
+ * All values are little-endian. The header is followed by the points, edges, faces,
+ * face edges, edge flags, strip offsets and strip indices, each stored exactly as in
+ * `goblin3d_obj_t` and starting on an 8-byte boundary. Sections whose flag is not set,
+ * or whose count is zero, are empty. Since sections are aligned and laid out like the
+ * in-memory arrays, a loaded or mapped file can be used in place.
+ */
+typedef struct {
+    char magic[4];               /**< `GOBLIN3D_BINARY_MAGIC`, without a terminating null. */
+    uint16_t version;            /**< Format version, `GOBLIN3D_BINARY_VERSION`. */
+    uint16_t flags;              /**< Bitwise OR of `GOBLIN3D_BINARY_*` flags. */
+    uint32_t point_count;        /**< The number of points. */
+    uint32_t edge_count;         /**< The number of edges. */
+    uint32_t face_count;         /**< The number of triangles, when `GOBLIN3D_BINARY_FACES` is set. */
+    uint32_t strip_count;        /**< The number of strips, when `GOBLIN3D_BINARY_STRIPS` is set. */
+    uint32_t strip_index_count;  /**< The total number of strip indices. */
+    float quantize_offset[3];    /**< Coordinate decoded from a quantized value of 0. */
+    float quantize_scale[3];     /**< Coordinate step of one quantized unit. */
+    uint32_t reserved[3];        /**< Reserved, written as zero. */
+} goblin3d_binary_header_t;
+
+/**
+ * @brief Structure representing one simplified level of detail of a 3D object.
+ * 
+ * A level holds its own edge set, referencing the points of the full object, and
+ * the sorted list of points those edges use, so that only these are transformed
+ * while the level is selected.
+ */
+typedef struct {
+    uint32_t (*edges)[2];        /**< Contiguous array of edges of this level, indexing the object's points. */
+    uint32_t* point_indices;     /**< Sorted indices of the points used by the edges of this level. */
+    uint32_t edge_count;         /**< The number of edges in this level. */
+    uint32_t point_count;        /**< The number of points used by this level. */
+    float max_radius;            /**< Projected bounding radius, in pixels, below which this level is used. */
+} goblin3d_lod_t;
+
 /**
  * @brief Structure representing a 3D object for rendering using the Goblin3D library.
  * 
@@ -70,10 +327,18 @@
  * parameters such as rotation angles and offsets.
  */
 typedef struct {
-    float** points;          /**< 2D array storing the projected 2D coordinates of each point after transformations. */
-    uint32_t** edges;         /**< 2D array storing pairs of indices that represent the edges connecting the points. */
-    float** orig_points;     /**< 2D array storing the original 3D coordinates of each point before any transformations. */
-    float** rotated_points;  /**< 2D array storing the 3D coordinates of each point after rotation but before projection. */
+    float (*points)[2];          /**< Contiguous array storing the projected 2D coordinates of each point after transformations. */
+    uint32_t (*edges)[2];        /**< Contiguous array storing pairs of indices that represent the edges connecting the points. */
+    float (*orig_points)[3];     /**< Contiguous array storing the original 3D coordinates of each point before any transformations. */
+    float (*rotated_points)[3];  /**< Contiguous array storing the 3D coordinates of each point after rotation but before projection. */
+    uint32_t (*faces)[3];        /**< Contiguous array storing triplets of point indices for each retained triangle, or `NULL` when faces are not kept. */
+    uint32_t (*face_edges)[3];   /**< Contiguous array storing the three edge indices of each triangle side, or `GOBLIN3D_NO_EDGE` for fan diagonals. */
+    uint8_t* edge_flags;     /**< Per-edge flags used for visibility tracking, allocated once faces are added. */
+    uint32_t* face_order;    /**< Back-to-front triangle order kept between frames for painter-mode filled rendering. */
+    uint32_t* strip_indices; /**< Point indices of all edge strips, stored one strip after another. */
+    uint32_t* strip_offsets; /**< Start offset of each strip in `strip_indices`, plus one trailing end offset. */
+    goblin3d_lod_t* lods;    /**< Array of progressively coarser levels of detail, or `NULL` when none were built. */
+    uint32_t* edge_table;    /**< Hash table of edge indices keyed by their points, allocated once faces are added. */
 
     float x_offset;          /**< Horizontal offset applied to the projected points. */
     float y_offset;          /**< Vertical offset applied to the projected points. */
@@ -84,7 +349,25 @@ typedef struct {
 
     uint32_t point_count;     /**< The number of points (vertices) in the 3D object. */
     uint32_t edge_count;      /**< The number of edges connecting the points in the 3D object. */
+    uint32_t face_count;      /**< The number of retained triangles in the 3D object. */
+    uint32_t dropped_count;   /**< The number of face and line records the parser dropped or kept only in part. */
+    uint32_t strip_count;     /**< The number of edge strips built by `goblin3d_build_strips`. */
     float scale_size;        /**< Scaling factor applied to the projected points. */
+    uint8_t render_flags;    /**< Bitwise OR of `GOBLIN3D_RENDER_*` flags controlling how the object is rendered. */
+    uint8_t lod_count;       /**< The number of levels in `lods`. */
+    uint8_t lod_level;       /**< Level selected by the last precalculation, 0 being the full mesh and `n` being `lods[n - 1]`. */
+    uint8_t edge_table_bits; /**< Base-2 logarithm of the number of slots in `edge_table`. */
+    float bound_center[3];   /**< Center of the bounding sphere and box of the original points. */
+    float bound_radius;      /**< Radius of the bounding sphere of the original points. */
+    float bound_min[3];      /**< Minimum corner of the axis-aligned bounding box of the original points. */
+    float bound_max[3];      /**< Maximum corner of the axis-aligned bounding box of the original points. */
+    bool bounds_valid;       /**< Whether the cached bounds match the current original points. */
+    uint16_t viewport_width;  /**< Width of the visible screen area used for culling, or 0 to disable it. */
+    uint16_t viewport_height; /**< Height of the visible screen area used for culling, or 0 to disable it. */
+    bool culled;             /**< Set by the last precalculation when the whole object lies outside the viewport. */
+    uint8_t borrowed;        /**< Internal mask of geometry arrays that point into memory the object does not own. */
+    const void* mapping;     /**< File mapping the borrowed arrays point into, unmapped by `goblin3d_free`, or `NULL`. */
+    size_t mapping_size;     /**< Size of `mapping`, in bytes. */
 } goblin3d_obj_t;
 
 /**
@@ -100,6 +383,196 @@ typedef struct {
  */
 typedef void (*goblin3d_obj_draw_fn)(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
 
+/**
+ * @brief Type definition for a callback function used to draw connected polylines.
+ * 
+ * This function type is used in the `goblin3d_render_strips` function. The points are
+ * interleaved X and Y coordinates, so the callback can forward them to `drawLines`-style
+ * APIs that draw `count - 1` connected segments in one call.
+ * 
+ * @param xy Array of `count * 2` interleaved X and Y coordinates.
+ * @param count The number of points in the polyline; always at least 2.
+ */
+typedef void (*goblin3d_obj_polyline_fn)(const uint16_t* xy, uint32_t count);
+
+/**
+ * @brief Type definition for a callback function used to plot a batch of points.
+ * 
+ * This function type is used in the `goblin3d_render_points` function. The points
+ * are interleaved X and Y coordinates and always lie within the target screen.
+ * 
+ * @param xy Array of `count * 2` interleaved X and Y coordinates.
+ * @param count The number of points in the batch; always at least 1.
+ */
+typedef void (*goblin3d_obj_points_fn)(const uint16_t* xy, uint32_t count);
+
+/**
+ * @brief Structure representing a coarse depth buffer used for hidden-line removal.
+ * 
+ * The buffer covers the screen at a reduced resolution, where each cell spans
+ * `1 << shift` pixels in both directions. Faces of an object are rasterized into
+ * it, keeping the depth of the nearest surface per cell, and edge samples are then
+ * tested against it to suppress occluded parts of the wireframe.
+ */
+typedef struct {
+    float* depth;            /**< Array of `width * height` depth values, larger values being closer to the viewer. */
+    uint16_t width;          /**< Number of cells horizontally. */
+    uint16_t height;         /**< Number of cells vertically. */
+    uint8_t shift;           /**< Downscale factor as a power of two (e.g., 2 for 1/4 resolution). */
+    float bias;              /**< Depth tolerance as a fraction of the object's depth range, to keep edges on their own faces visible. */
+} goblin3d_depth_t;
+
+/**
+ * @brief Structure representing a screen-space occupancy mask used to decimate point clouds.
+ * 
+ * The mask holds one bit per cell, where each cell spans `1 << shift` pixels in both
+ * directions. A point landing on a cell that is already lit is skipped, so dense
+ * clouds cost one bit test per hidden point instead of one plot.
+ */
+typedef struct {
+    uint32_t* bits;          /**< Array of `width * height` bits, packed 32 per word. */
+    uint16_t width;          /**< Number of cells horizontally. */
+    uint16_t height;         /**< Number of cells vertically. */
+    uint8_t shift;           /**< Cell size as a power of two (e.g., 0 for one bit per pixel). */
+} goblin3d_occupancy_t;
+
+/**
+ * @brief Structure representing an RGB565 framebuffer for filled rendering.
+ * 
+ * The optional depth buffer enables z-buffered rendering. When it is `NULL`,
+ * triangles are drawn back-to-front instead (painter mode).
+ */
+typedef struct {
+    uint16_t* pixels;        /**< Array of `width * height` RGB565 pixels, row by row. */
+    float* depth;            /**< Optional array of `width * height` depth values, or `NULL` for painter mode. */
+    uint16_t width;          /**< Width of the framebuffer, in pixels. */
+    uint16_t height;         /**< Height of the framebuffer, in pixels. */
+} goblin3d_framebuffer_t;
+
+/**
+ * @brief Structure holding the state of an OBJ file being loaded in the background.
+ * 
+ * The object is built in `result`, away from the object being rendered, and only
+ * handed over by `goblin3d_load_publish` once it is complete. `status` and `percent`
+ * may be written by a worker thread and are read through `goblin3d_load_status`.
+ */
+typedef struct {
+    void* state;             /**< Internal parser and file state, or `NULL` when no load is running. */
+    goblin3d_obj_t result;   /**< Object being built by the load. */
+    uint8_t status;          /**< One of the `GOBLIN3D_LOAD_*` status values. */
+    uint8_t percent;         /**< Progress of the load, from 0 to 100. */
+} goblin3d_loader_t;
+
+/**
+ * @brief Structure representing the rotation of one frame of a baked animation.
+ */
+typedef struct {
+    float x_angle_deg;       /**< Rotation angle around the X-axis, in degrees. */
+    float y_angle_deg;       /**< Rotation angle around the Y-axis, in degrees. */
+    float z_angle_deg;       /**< Rotation angle around the Z-axis, in degrees. */
+} goblin3d_keyframe_t;
+
+/**
+ * @brief Structure holding the projected points of every frame of a baked animation.
+ * 
+ * Points are stored as 16-bit screen coordinates, a quarter of the memory of the
+ * projected floats, so that loops of a few hundred frames of small models fit in
+ * the flash of a microcontroller.
+ */
+typedef struct {
+    int16_t (*points)[2];    /**< Projected points of all frames, `point_count` per frame, one frame after another. */
+    uint32_t point_count;    /**< The number of points per frame, matching the baked object. */
+    uint32_t frame_count;    /**< The number of frames. */
+    bool borrowed;           /**< Whether `points` points into memory the animation does not own. */
+} goblin3d_animation_t;
+
+/**
+ * @brief Structure describing the flat shading applied to filled triangles.
+ * 
+ * Every triangle is drawn in a single colour, obtained by scaling the base colour
+ * with the Lambertian term of the triangle normal against the light direction.
+ */
+typedef struct {
+    float light[3];          /**< Unit direction pointing towards the light, in rotated (view) space. */
+    float ambient;           /**< Minimum intensity applied to unlit triangles, from 0.0 to 1.0. */
+    uint16_t color;          /**< Base RGB565 colour of the object. */
+} goblin3d_shading_t;
+
+/**
+ * @brief Type definition for a callback function used to fill horizontal spans.
+ * 
+ * This function type is used in `goblin3d_render_filled_spans`. It maps directly to
+ * calls such as `drawFastHLine` or `fillRect` with a height of one on TFT libraries.
+ * 
+ * @param x The X-coordinate of the leftmost pixel of the span.
+ * @param y The Y-coordinate of the span.
+ * @param length The number of pixels in the span.
+ * @param color The RGB565 colour of the span.
+ */
+typedef void (*goblin3d_obj_span_fn)(uint16_t x, uint16_t y, uint16_t length, uint16_t color);
+
+#ifdef GOBLIN3D_POSIX
+/**
+ * @brief Structure holding the state of the tile-binned multi-threaded renderer.
+ * 
+ * The screen is split into `GOBLIN3D_TILE_SIZE` square tiles. Projected edges are
+ * binned into every tile they cross, and worker threads then rasterize whole
+ * tiles at a time. Since each tile is owned by exactly one worker, the shared
+ * framebuffer is written without any locking. The worker threads and the bin
+ * storage are kept between frames, so steady-state rendering neither creates
+ * threads nor allocates; each phase is handed to the sleeping workers through a
+ * condition variable.
+ */
+typedef struct {
+    uint32_t* counts;        /**< Per-thread, per-tile edge counts, turned into write cursors while binning. */
+    uint32_t* tile_start;    /**< Offset of each tile's edge list in `bins`, plus one trailing end offset. */
+    uint32_t* bins;          /**< Edge indices grouped by tile. */
+    uint32_t bin_capacity;   /**< Number of entries allocated in `bins`. */
+    uint16_t tiles_x;        /**< Number of tiles horizontally. */
+    uint16_t tiles_y;        /**< Number of tiles vertically. */
+    uint8_t thread_count;    /**< Number of worker threads used for binning and rasterization. */
+    void* workers;           /**< Internal per-thread state of the workers, including the calling thread. */
+    pthread_t* threads;      /**< Worker threads, started by `goblin3d_tiler_init`; the calling thread is worker 0. */
+    pthread_mutex_t lock;    /**< Guards the dispatch state below. */
+    pthread_cond_t start;    /**< Signalled when a phase is dispatched to the workers. */
+    pthread_cond_t done;     /**< Signalled when the last worker finishes its part of a phase. */
+    uint32_t generation;     /**< Number of phases dispatched so far. */
+    uint8_t pending;         /**< Number of workers still running the current phase. */
+    bool stopping;           /**< Set by `goblin3d_tiler_free` to make the workers exit. */
+} goblin3d_tiler_t;
+
+/**
+ * @brief Structure holding a memory-mapped binary mesh rendered without loading it.
+ * 
+ * The points and edges are read straight from the mapping, and projected points
+ * are kept in a fixed-size window indexed by point index, so the memory used by
+ * the renderer does not depend on the size of the mesh. The transformation fields
+ * are set by the caller and behave as in `goblin3d_obj_t`.
+ */
+typedef struct {
+    const char* mapping;         /**< Start of the mapped file. */
+    size_t mapping_size;         /**< Size of `mapping`, in bytes. */
+    const uint8_t* points;       /**< Point section of the mapped file, as floats or quantized values. */
+    const uint32_t (*edges)[2];  /**< Edge section of the mapped file. */
+    float (*window)[2];          /**< Projected coordinates of the points currently held in the window. */
+    uint32_t* window_tags;       /**< Index of the point held in each window slot, or `0xFFFFFFFF` for none. */
+    uint32_t window_mask;        /**< Number of window slots minus one; the slot count is a power of two. */
+    uint32_t point_count;        /**< The number of points in the mesh. */
+    uint32_t edge_count;         /**< The number of edges in the mesh. */
+    bool quantized;              /**< Whether points are stored as 16-bit quantized coordinates. */
+    float quantize_offset[3];    /**< Coordinate decoded from a quantized value of 0. */
+    float quantize_scale[3];     /**< Coordinate step of one quantized unit. */
+
+    float x_offset;              /**< Horizontal offset applied to the projected points. */
+    float y_offset;              /**< Vertical offset applied to the projected points. */
+    float z_offset;              /**< Depth offset applied to the projected points. */
+    float x_angle_deg;           /**< Rotation angle around the X-axis, in degrees. */
+    float y_angle_deg;           /**< Rotation angle around the Y-axis, in degrees. */
+    float z_angle_deg;           /**< Rotation angle around the Z-axis, in degrees. */
+    float scale_size;            /**< Scaling factor applied to the projected points. */
+} goblin3d_stream_t;
+#endif
+
 /**
  * @brief Initializes a 3D object structure.
  * 
@@ -126,6 +599,24 @@ bool goblin3d_init(goblin3d_obj_t* obj, uint32_t point_count, uint32_t edge_coun
  */
 void goblin3d_init_empty(goblin3d_obj_t* obj);
 
+/**
+ * @brief Initializes a 3D object from constant point and edge tables.
+ * 
+ * The tables are used in place without copying, so meshes generated as `const` arrays
+ * (for example by the `goblin3d_convert` tool) can stay in flash. Only the projected
+ * and rotated point buffers are allocated. The tables must stay valid for the lifetime
+ * of the object; functions that add to or rearrange the geometry copy them to the heap first.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure to initialize.
+ * @param points The points (vertices) of the 3D object.
+ * @param point_count The number of points in `points`.
+ * @param edges The edges of the 3D object as pairs of point indices.
+ * @param edge_count The number of edges in `edges`.
+ * @return `true` if initialization is successful, `false` if a memory allocation error occurred.
+ */
+bool goblin3d_init_from_arrays(goblin3d_obj_t* obj, const float (*points)[3], uint32_t point_count,
+    const uint32_t (*edges)[2], uint32_t edge_count);
+
 /**
  * @brief Frees the memory associated with a 3D object structure.
  * 
@@ -136,6 +627,17 @@ void goblin3d_init_empty(goblin3d_obj_t* obj);
  */
 void goblin3d_free(goblin3d_obj_t* obj);
 
+/**
+ * @brief Recomputes the cached bounding sphere and box of a 3D object.
+ * 
+ * Bounds are refreshed automatically when points are added through `goblin3d_add_point`
+ * or the object is simplified. Call this after writing to `orig_points` directly, so
+ * that viewport culling and level-of-detail selection see the new geometry.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure whose bounds are updated.
+ */
+void goblin3d_update_bounds(goblin3d_obj_t* obj);
+
 /**
  * @brief Precalculates the rotated and projected points for a 3D object.
  * 
@@ -204,6 +706,15 @@ void goblin3d_free(goblin3d_obj_t* obj);
  * The z-coordinate is clamped to a minimum value to avoid division by zero or very small
  * values, which could cause large distortions.
  * 
+ * When `GOBLIN3D_RENDER_LOD` is set in `render_flags`, the bounding sphere is projected
+ * first to select a level of detail, and only the points of that level are transformed.
+ * 
+ * When `viewport_width` and `viewport_height` are set, the rotated bounds are projected
+ * before any point is transformed. If they fall entirely outside the viewport, `culled`
+ * is set, no point is transformed, and every render function returns without drawing.
+ * Because the projection clamps depth instead of clipping against a near plane, the
+ * viewport edges are the only planes an object can be rejected against.
+ * 
  * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
  */
 void goblin3d_precalculate(goblin3d_obj_t* obj);
@@ -215,11 +726,277 @@ void goblin3d_precalculate(goblin3d_obj_t* obj);
  * edges of the 3D object. A callback function is used to perform the actual drawing,
  * allowing for flexibility in the rendering method.
  * 
+ * If `GOBLIN3D_RENDER_CULL_BACKFACES` is set in `render_flags` and the object has
+ * retained faces, the winding of every triangle is computed from the projected points.
+ * A triangle is front-facing when its projected corners are ordered counter-clockwise,
+ * matching the counter-clockwise winding of Wavefront OBJ faces. Edges that only border
+ * back-facing triangles are skipped, while edges not attached to any face are always drawn.
+ * 
  * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
  * @param draw A callback function used to draw lines between the points on the 2D plane.
  */
 void goblin3d_render(goblin3d_obj_t* obj, goblin3d_obj_draw_fn draw);
 
+/**
+ * @brief Renders the 3D object by drawing its edge strips as polylines.
+ * 
+ * This function walks the strips built by `goblin3d_build_strips`, so each shared
+ * point is read and handed to the callback about once per strip instead of once
+ * per incident edge. Strips longer than `GOBLIN3D_STRIP_BATCH` points are split
+ * into several callbacks. Back-face culling does not apply to strips.
+ * 
+ * Objects without strips are rendered edge by edge as two-point polylines.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
+ * @param polyline A callback function used to draw connected polylines.
+ */
+void goblin3d_render_strips(goblin3d_obj_t* obj, goblin3d_obj_polyline_fn polyline);
+
+/**
+ * @brief Initializes a coarse depth buffer for hidden-line rendering.
+ * 
+ * This function allocates a depth buffer covering a screen of the given size at
+ * `1 / (1 << shift)` of its resolution in each direction. A `shift` of 2 gives a
+ * 1/4 resolution buffer, which is usually enough for wireframes while keeping the
+ * memory footprint small on microcontrollers. The depth bias defaults to 0.02.
+ * 
+ * @param depth Pointer to the `goblin3d_depth_t` structure to initialize.
+ * @param screen_width The width of the target screen, in pixels.
+ * @param screen_height The height of the target screen, in pixels.
+ * @param shift The downscale factor as a power of two.
+ * @return `true` if initialization is successful, `false` otherwise.
+ */
+bool goblin3d_depth_init(goblin3d_depth_t* depth, uint16_t screen_width, uint16_t screen_height, uint8_t shift);
+
+/**
+ * @brief Frees the memory associated with a coarse depth buffer.
+ * 
+ * @param depth Pointer to the `goblin3d_depth_t` structure to free.
+ */
+void goblin3d_depth_free(goblin3d_depth_t* depth);
+
+/**
+ * @brief Renders the 3D object with hidden lines removed.
+ * 
+ * This function rasterizes the retained faces of the object into the coarse depth
+ * buffer, then walks every edge in steps of one depth cell and compares the
+ * interpolated edge depth against the buffer. Only the visible runs of each edge
+ * are passed to the `draw` callback, so partially hidden edges are split into
+ * shorter segments. Back-face culling is applied first when enabled in `render_flags`.
+ * 
+ * Objects without retained faces are rendered as with `goblin3d_render`.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
+ * @param depth Pointer to an initialized `goblin3d_depth_t` covering the target screen.
+ * @param draw A callback function used to draw lines between the points on the 2D plane.
+ */
+void goblin3d_render_hidden(goblin3d_obj_t* obj, goblin3d_depth_t* depth, goblin3d_obj_draw_fn draw);
+
+/**
+ * @brief Initializes an RGB565 framebuffer.
+ * 
+ * @param fb Pointer to the `goblin3d_framebuffer_t` structure to initialize.
+ * @param width The width of the framebuffer, in pixels.
+ * @param height The height of the framebuffer, in pixels.
+ * @param with_depth Whether to allocate a depth buffer for z-buffered rendering.
+ * @return `true` if initialization is successful, `false` otherwise.
+ */
+bool goblin3d_framebuffer_init(goblin3d_framebuffer_t* fb, uint16_t width, uint16_t height, bool with_depth);
+
+/**
+ * @brief Frees the memory associated with a framebuffer.
+ * 
+ * @param fb Pointer to the `goblin3d_framebuffer_t` structure to free.
+ */
+void goblin3d_framebuffer_free(goblin3d_framebuffer_t* fb);
+
+/**
+ * @brief Clears a framebuffer to a colour and resets its depth buffer.
+ * 
+ * @param fb Pointer to the `goblin3d_framebuffer_t` structure to clear.
+ * @param color The RGB565 colour to fill the framebuffer with.
+ */
+void goblin3d_framebuffer_clear(goblin3d_framebuffer_t* fb, uint16_t color);
+
+/**
+ * @brief Renders the retained faces of the 3D object as flat-shaded filled triangles.
+ * 
+ * Triangles are rasterized span by span: integer edge functions evaluated on the
+ * snapped projected points give, for each scanline, the exact range of covered
+ * pixels under a top-left fill rule, and that range is filled in one pass. With a
+ * depth buffer, each span is depth-tested per pixel; without one, triangles are
+ * drawn back-to-front using an order kept from the previous frame, which makes
+ * the sort nearly linear for animated objects.
+ * 
+ * Back-facing triangles are skipped when `GOBLIN3D_RENDER_CULL_BACKFACES` is set in
+ * `render_flags`, and lit from their other side otherwise.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
+ * @param fb Pointer to the target framebuffer.
+ * @param shading Pointer to the shading parameters.
+ * @return `true` if rendering succeeded, `false` if a memory allocation error occurred.
+ */
+bool goblin3d_render_filled(goblin3d_obj_t* obj, goblin3d_framebuffer_t* fb, const goblin3d_shading_t* shading);
+
+/**
+ * @brief Renders the retained faces of the 3D object as filled spans through a callback.
+ * 
+ * This function rasterizes like `goblin3d_render_filled` in painter mode, but hands
+ * every horizontal span to a callback instead of writing into a framebuffer. This
+ * lets displays without a local framebuffer fill triangles with one transaction
+ * per scanline.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
+ * @param width The width of the target screen, used for clipping.
+ * @param height The height of the target screen, used for clipping.
+ * @param shading Pointer to the shading parameters.
+ * @param span A callback function used to fill horizontal spans.
+ * @return `true` if rendering succeeded, `false` if a memory allocation error occurred.
+ */
+bool goblin3d_render_filled_spans(goblin3d_obj_t* obj, uint16_t width, uint16_t height,
+    const goblin3d_shading_t* shading, goblin3d_obj_span_fn span);
+
+/**
+ * @brief Initializes a screen-space occupancy mask for point rendering.
+ * 
+ * A `shift` of 0 skips only points landing on an already plotted pixel, while larger
+ * values thin out dense clouds further by keeping one point per `1 << shift` square.
+ * 
+ * @param occupancy Pointer to the `goblin3d_occupancy_t` structure to initialize.
+ * @param screen_width The width of the target screen, in pixels.
+ * @param screen_height The height of the target screen, in pixels.
+ * @param shift The cell size as a power of two.
+ * @return `true` if initialization is successful, `false` otherwise.
+ */
+bool goblin3d_occupancy_init(goblin3d_occupancy_t* occupancy, uint16_t screen_width, uint16_t screen_height, uint8_t shift);
+
+/**
+ * @brief Frees the memory associated with a screen-space occupancy mask.
+ * 
+ * @param occupancy Pointer to the `goblin3d_occupancy_t` structure to free.
+ */
+void goblin3d_occupancy_free(goblin3d_occupancy_t* occupancy);
+
+/**
+ * @brief Renders the points of the 3D object through a batched callback.
+ * 
+ * This function draws the projected points computed by `goblin3d_precalculate`,
+ * which makes it suitable for point clouds that have no edges. Points outside the
+ * screen are clipped, and the remaining ones are handed to the callback in batches
+ * of up to `GOBLIN3D_POINT_BATCH`. When a level of detail is selected, only its
+ * points are drawn.
+ * 
+ * With an occupancy mask, which is cleared at the start of every call, points
+ * landing on an already lit cell are skipped.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
+ * @param width The width of the target screen, used for clipping.
+ * @param height The height of the target screen, used for clipping.
+ * @param occupancy Pointer to an initialized occupancy mask covering the screen, or `NULL`.
+ * @param plot A callback function used to plot batches of points.
+ */
+void goblin3d_render_points(goblin3d_obj_t* obj, uint16_t width, uint16_t height,
+    goblin3d_occupancy_t* occupancy, goblin3d_obj_points_fn plot);
+
+/**
+ * @brief Renders the points of the 3D object into a framebuffer.
+ * 
+ * Points are shaded by depth, from the full `color` at the front of the object's
+ * bounding sphere down to `min_intensity` times that colour at its back, using a
+ * small palette computed once per call. With a depth buffer, each point is
+ * depth-tested so nearer points stay on top; without one, points are drawn in order.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
+ * @param fb Pointer to the target framebuffer.
+ * @param color The RGB565 colour of the nearest points.
+ * @param min_intensity Intensity of the farthest points, from 0.0 to 1.0; 1.0 disables depth shading.
+ */
+void goblin3d_render_points_fb(goblin3d_obj_t* obj, goblin3d_framebuffer_t* fb, uint16_t color, float min_intensity);
+
+/**
+ * @brief Precomputes the projected points of a rotation loop.
+ * 
+ * Every keyframe is transformed and projected like `goblin3d_precalculate` would with
+ * its angles and the object's current offsets and scale, and the projected points are
+ * stored as 16-bit coordinates. Viewport culling and levels of detail do not apply;
+ * all points are baked. The object itself, including its projected points, is left unchanged.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
+ * @param keyframes Array of `count` keyframes, one per frame.
+ * @param count The number of frames to bake.
+ * @param animation Pointer to the `goblin3d_animation_t` structure to fill.
+ * @return `true` if the animation was baked, `false` if a memory allocation error occurred.
+ */
+bool goblin3d_bake_animation(const goblin3d_obj_t* obj, const goblin3d_keyframe_t* keyframes, uint32_t count,
+    goblin3d_animation_t* animation);
+
+/**
+ * @brief Frees the memory associated with a baked animation.
+ * 
+ * @param animation Pointer to the `goblin3d_animation_t` structure to free.
+ */
+void goblin3d_animation_free(goblin3d_animation_t* animation);
+
+/**
+ * @brief Renders one frame of a baked animation.
+ * 
+ * The edges of the object are drawn between the baked points of the frame, with no
+ * transformation at all, so `goblin3d_precalculate` must not be called for it. Frame
+ * numbers wrap around the frame count, so a running counter loops the animation.
+ * Nothing is drawn if the animation was baked from an object with another point count.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure the animation was baked from.
+ * @param animation Pointer to the baked animation.
+ * @param frame The frame to draw.
+ * @param draw A callback function used to draw lines between the points on the 2D plane.
+ */
+void goblin3d_render_frame(goblin3d_obj_t* obj, const goblin3d_animation_t* animation, uint32_t frame,
+    goblin3d_obj_draw_fn draw);
+
+#ifdef GOBLIN3D_POSIX
+/**
+ * @brief Initializes the tile-binned multi-threaded renderer.
+ * 
+ * The `thread_count - 1` worker threads are started here and wait for work until
+ * `goblin3d_tiler_free` is called.
+ * 
+ * @param tiler Pointer to the `goblin3d_tiler_t` structure to initialize.
+ * @param width The width of the target framebuffer, in pixels.
+ * @param height The height of the target framebuffer, in pixels.
+ * @param thread_count The number of worker threads to use; at least 1.
+ * @return `true` if initialization is successful, `false` otherwise.
+ */
+bool goblin3d_tiler_init(goblin3d_tiler_t* tiler, uint16_t width, uint16_t height, uint8_t thread_count);
+
+/**
+ * @brief Stops the worker threads and frees the memory associated with the tiled renderer.
+ * 
+ * @param tiler Pointer to the `goblin3d_tiler_t` structure to free.
+ */
+void goblin3d_tiler_free(goblin3d_tiler_t* tiler);
+
+/**
+ * @brief Renders the edges of the 3D object into a framebuffer using several threads.
+ * 
+ * Rendering runs in three parallel phases. Workers first count, for their share
+ * of the edges, how many cross each tile; the counts are then prefix-summed into
+ * per-worker write cursors so that the second phase can fill the bins without
+ * contention. Finally, tiles are rasterized in parallel: each worker owns a range
+ * of tiles and steals tiles from the other workers once its own range is done.
+ * 
+ * Lines are rasterized so that each pixel only depends on the line itself, so an
+ * edge split across several tiles matches the line drawn in one piece. Back-face
+ * culling is honoured when enabled in `render_flags`.
+ * 
+ * @param obj Pointer to the `goblin3d_obj_t` structure containing the 3D object data.
+ * @param tiler Pointer to a tiled renderer initialized for the framebuffer size.
+ * @param fb Pointer to the target framebuffer.
+ * @param color The RGB565 colour of the lines.
+ * @return `true` if rendering succeeded, `false` if a memory allocation error occurred.
+ */
+bool goblin3d_render_tiled(goblin3d_obj_t* obj, goblin3d_tiler_t* tiler, goblin3d_framebuffer_t* fb, uint16_t color);
+#endif
+
 /**
  * @brief Adds a 3D point to a Goblin3D object.
  * 
@@ -242,7 +1019,8 @@ bool goblin3d_add_point(goblin3d_obj_t* obj, float x, float y, float z);
  * This function checks whether an edge exists between two specified vertices 
  * (identified by their indices) in the Goblin3D object's edges array. An edge 
  * is considered to exist if there is an edge in the array that connects the 
- * two vertices in either order.
+ * two vertices in either order. Once faces have been added, the lookup goes
+ * through the object's edge table instead of scanning the array.
  * 
  * @param obj A pointer to the Goblin3D object.
  * @param v1 The index of the first vertex.
@@ -267,6 +1045,119 @@ bool goblin3d_edge_exists(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2);
  */
 bool goblin3d_add_edge(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2);
 
+/**
+ * @brief Adds a polygonal face to a Goblin3D object.
+ * 
+ * This function adds the boundary edges of a polygon (deduplicated like `goblin3d_add_edge`)
+ * and retains the polygon as a fan of triangles in the `faces` array. Each triangle
+ * also records the indices of the edges along its sides in `face_edges`, which is
+ * what back-face culling uses to decide which edges are visible.
+ * 
+ * Existing edges are found through a hash table, `edge_table`, built on the first
+ * call and kept up to date by later `goblin3d_add_edge` and `goblin3d_add_face`
+ * calls, so building a mesh face by face takes linear time. Functions that rebuild
+ * the edge array, such as `goblin3d_weld`, drop the table.
+ * 
+ * @param obj A pointer to the Goblin3D object.
+ * @param indices Array of point indices of the polygon, in counter-clockwise order.
+ * @param count The number of indices in the polygon; must be at least 3.
+ * @return `true` if the face was added successfully, `false` if the polygon has
+ *         fewer than 3 points, repeats a point, or a memory allocation error occurred.
+ */
+bool goblin3d_add_face(goblin3d_obj_t* obj, const uint32_t* indices, uint32_t count);
+
+/**
+ * @brief Reorders the points, edges and faces of a Goblin3D object for memory locality.
+ * 
+ * Meshes loaded from OBJ files list edges in face order, which makes rendering jump
+ * around the point arrays once meshes get large. This function renumbers points in
+ * the order they are first used by the edges (unused points are moved to the end),
+ * stores every edge with its lower index first, and sorts edges by their point
+ * indices. Faces are remapped and sorted by their lowest point index as well.
+ * Afterwards, both `goblin3d_precalculate` and `goblin3d_render` walk memory
+ * almost sequentially. The set of rendered edges is unchanged.
+ * 
+ * It is meant to be called once after loading; the original indices are not kept.
+ * 
+ * @param obj A pointer to the Goblin3D object to optimize.
+ * @return `true` if the object was optimized, `false` if a memory allocation error occurred
+ *         (the object is left unchanged in that case).
+ */
+bool goblin3d_optimize(goblin3d_obj_t* obj);
+
+/**
+ * @brief Stitches the edges of a Goblin3D object into maximal polylines.
+ * 
+ * This function decomposes the edge graph into strips in the spirit of an Euler path:
+ * walks start at points of odd degree first, since every decomposition needs a strip
+ * ending at each of them, and each walk follows unused edges until it gets stuck.
+ * A strip of `n` points covers `n - 1` edges, so on typical meshes the strips hold
+ * close to half the indices of the edge list. Existing strips are replaced.
+ * 
+ * Adding points or edges discards the strips, so they must be rebuilt after editing.
+ * 
+ * @param obj A pointer to the Goblin3D object.
+ * @return `true` if the strips were built successfully, `false` if a memory allocation
+ *         error occurred.
+ */
+bool goblin3d_build_strips(goblin3d_obj_t* obj);
+
+/**
+ * @brief Builds progressively coarser levels of detail for a Goblin3D object.
+ * 
+ * Each level is derived from the previous one by the quadric edge-collapse simplifier
+ * of `goblin3d_simplify`, collapsing edges onto one of their endpoints so all levels
+ * share the object's points, until about half the edges are left.
+ * Level `n` is used once the projected bounding radius drops below
+ * `pixel_radius / 2^(n - 1)` pixels. The bounding sphere is computed as well.
+ * Fewer levels are built if the mesh cannot be simplified any further.
+ * 
+ * @param obj A pointer to the Goblin3D object.
+ * @param levels The number of coarser levels to build.
+ * @param pixel_radius The projected radius, in pixels, below which the first coarser level is used.
+ * @return `true` if the levels were built successfully, `false` if a memory allocation
+ *         error occurred.
+ */
+bool goblin3d_build_lods(goblin3d_obj_t* obj, uint8_t levels, float pixel_radius);
+
+/**
+ * @brief Simplifies a Goblin3D object using quadric error metrics.
+ * 
+ * Every point accumulates a quadric measuring the squared distance to the planes of
+ * its adjacent faces (or, for objects without retained faces, to the lines of its
+ * adjacent edges). Edges are then collapsed in order of increasing error, each
+ * collapse merging both endpoints into the position minimizing the combined quadric,
+ * until at most `target_edges` edges are left or nothing can be collapsed.
+ * 
+ * Points, edges and faces are rewritten in place, with duplicate edges and degenerate
+ * faces removed. Strips and levels of detail are discarded and need to be rebuilt.
+ * This is meant for reducing oversized models offline on desktop or right after
+ * loading, so that a single source model can serve both high and low resolution displays.
+ * 
+ * @param obj A pointer to the Goblin3D object to simplify.
+ * @param target_edges The maximum number of edges to keep.
+ * @return `true` if the object was simplified, `false` if a memory allocation error occurred
+ *         (the object is left unchanged in that case).
+ */
+bool goblin3d_simplify(goblin3d_obj_t* obj, uint32_t target_edges);
+
+/**
+ * @brief Merges the points of a Goblin3D object that lie within a given distance.
+ * 
+ * Points are inserted into a spatial hash grid with cells twice `epsilon` wide, and
+ * each point is merged into the first earlier point found within `epsilon`, searching
+ * its own cell and the neighboring cells on its nearer side along each axis. With an `epsilon` of 0, only points at exactly the same position
+ * are merged. Edges are then remapped, and edges that collapsed to a single point or
+ * duplicate an earlier edge are removed; faces are remapped the same way.
+ * Strips and levels of detail are discarded and need to be rebuilt.
+ * 
+ * @param obj A pointer to the Goblin3D object to weld.
+ * @param epsilon The largest distance between two points that are merged.
+ * @return `true` if the object was welded, `false` if a memory allocation error occurred
+ *         (the object is left unchanged in that case).
+ */
+bool goblin3d_weld(goblin3d_obj_t* obj, float epsilon);
+
 /**
  * @brief Parses an OBJ file to construct a Goblin3D object.
  * 
@@ -275,6 +1166,13 @@ bool goblin3d_add_edge(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2);
  * adds the corresponding points and edges to the Goblin3D object. The OBJ file should 
  * be formatted according to the standard OBJ file format specification.
  * 
+ * The file is read in blocks of `GOBLIN3D_PARSE_BLOCK_SIZE` bytes (from the SD card on
+ * Arduino) and tokenized in place in a single pass. Vertices (`v`), faces (`f`) and polylines (`l`) are read; faces may
+ * use the `v/vt/vn` syntax, negative (relative) indices and any number of corners.
+ * Records referencing undefined vertices are skipped and counted in `dropped_count`,
+ * duplicate edges are merged through a hash table, and arrays grow geometrically
+ * before being trimmed to size.
+ * 
  * @param filename The path to the OBJ file to parse.
  * @param obj A pointer to the Goblin3D object to populate.
  * @return `true` if the OBJ file was successfully parsed and the object constructed, 
@@ -282,4 +1180,408 @@ bool goblin3d_add_edge(goblin3d_obj_t* obj, uint32_t v1, uint32_t v2);
  */
 bool goblin3d_parse_obj_file(const char* filename, goblin3d_obj_t* obj);
 
+/**
+ * @brief Parses an OBJ file to construct a Goblin3D object, with parsing options.
+ * 
+ * This function behaves like `goblin3d_parse_obj_file`, but accepts a set of
+ * `GOBLIN3D_PARSE_*` flags. With `GOBLIN3D_PARSE_KEEP_FACES`, faces are retained,
+ * split into triangle fans as `goblin3d_add_face` does, so they can be used for
+ * back-face culling and filled rendering. Fan triangles that repeat a point are
+ * not kept, and each face record that loses one is counted in `dropped_count`.
+ * 
+ * @param filename The path to the OBJ file to parse.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags.
+ * @return `true` if the OBJ file was successfully parsed and the object constructed, 
+ *         `false` if an error occurred (e.g., file not found, memory allocation failure).
+ */
+bool goblin3d_parse_obj_file_ex(const char* filename, goblin3d_obj_t* obj, uint8_t flags);
+
+/**
+ * @brief Starts loading an OBJ file in resumable slices.
+ * 
+ * The file is opened and nothing is parsed yet; the work is done by later calls to
+ * `goblin3d_load_step`. This lets a single-threaded application, such as an Arduino
+ * sketch, keep its render loop running while a model streams in from the SD card.
+ * 
+ * @param loader Pointer to the `goblin3d_loader_t` structure to initialize.
+ * @param filename The path to the OBJ file to load.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags; `GOBLIN3D_PARSE_MMAP` and
+ *        `GOBLIN3D_PARSE_CACHE` do not apply.
+ * @return `true` if the load was started, `false` if the file could not be opened or
+ *         a memory allocation error occurred.
+ */
+bool goblin3d_load_begin(goblin3d_loader_t* loader, const char* filename, uint8_t flags);
+
+/**
+ * @brief Continues a load started by `goblin3d_load_begin` for a limited time.
+ * 
+ * Blocks of `GOBLIN3D_PARSE_BLOCK_SIZE` bytes are read and parsed until `budget_ms`
+ * milliseconds have passed, so a call may overrun its budget by the time of one block.
+ * At least one block is parsed per call. Allocating the exact arrays between the two
+ * passes of `GOBLIN3D_PARSE_EXACT`, and welding with `GOBLIN3D_PARSE_WELD`, are each
+ * done within a single call. A loader started by `goblin3d_load_start` is not stepped;
+ * its status is returned as by `goblin3d_load_status`.
+ * 
+ * @param loader Pointer to a loader started by `goblin3d_load_begin`.
+ * @param budget_ms The time to spend parsing, in milliseconds.
+ * @return The status of the load, `GOBLIN3D_LOAD_RUNNING` until the file is complete.
+ */
+uint8_t goblin3d_load_step(goblin3d_loader_t* loader, uint32_t budget_ms);
+
+#ifdef GOBLIN3D_POSIX
+/**
+ * @brief Starts loading an OBJ file on a worker thread.
+ * 
+ * The worker parses the file block by block, updating the progress as it goes,
+ * while the calling thread keeps rendering. With `GOBLIN3D_PARSE_CACHE`, the worker
+ * first loads a valid cache if there is one, and the progress jumps to 100. Otherwise
+ * it parses block by block as usual, can be cancelled between blocks, and writes the
+ * cache once the file is complete.
+ * 
+ * @param loader Pointer to the `goblin3d_loader_t` structure to initialize.
+ * @param filename The path to the OBJ file to load.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags; `GOBLIN3D_PARSE_MMAP` does not apply.
+ * @return `true` if the worker was started, `false` if the file could not be opened, a
+ *         memory allocation error occurred or the thread could not be created.
+ */
+bool goblin3d_load_start(goblin3d_loader_t* loader, const char* filename, uint8_t flags);
+#endif
+
+/**
+ * @brief Reads the status and progress of a load.
+ * 
+ * This function is safe to call while a worker thread is parsing.
+ * 
+ * @param loader Pointer to the loader.
+ * @param percent Pointer receiving the progress from 0 to 100, or `NULL`.
+ * @return One of the `GOBLIN3D_LOAD_*` status values.
+ */
+uint8_t goblin3d_load_status(goblin3d_loader_t* loader, uint8_t* percent);
+
+/**
+ * @brief Replaces an object with the result of a completed load.
+ * 
+ * When the load is done, the geometry of `obj` is freed and replaced by the loaded
+ * one in a single call, while its offsets, angles, scale, render flags and viewport
+ * are kept, so a render loop that calls this between frames never sees a partially
+ * built object. The loader is then idle again. While the load is running, or after
+ * it failed, `obj` is left untouched.
+ * 
+ * @param loader Pointer to the loader.
+ * @param obj Pointer to the object to replace; it must be initialized, possibly empty.
+ * @return `true` if the object was replaced, `false` otherwise.
+ */
+bool goblin3d_load_publish(goblin3d_loader_t* loader, goblin3d_obj_t* obj);
+
+/**
+ * @brief Stops a load and frees everything it allocated.
+ * 
+ * A running worker thread is asked to stop after its current block and joined. The
+ * loader is idle afterwards. This must also be called after a failed load.
+ * 
+ * @param loader Pointer to the loader.
+ */
+void goblin3d_load_cancel(goblin3d_loader_t* loader);
+
+/**
+ * @brief Parses OBJ data held in memory to construct a Goblin3D object.
+ * 
+ * This function runs the same tokenizer as `goblin3d_parse_obj_file` directly over
+ * `data`, so models embedded in firmware, received over a network or otherwise already
+ * in RAM can be loaded without going through a filesystem. The data is not copied, does
+ * not need to be null-terminated, and may be released once this function returns.
+ * 
+ * @param data Pointer to the OBJ text.
+ * @param length The number of bytes in `data`.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @return `true` if the data was successfully parsed and the object constructed,
+ *         `false` if a memory allocation error occurred.
+ */
+bool goblin3d_parse_obj_buffer(const char* data, size_t length, goblin3d_obj_t* obj);
+
+/**
+ * @brief Parses OBJ data held in memory to construct a Goblin3D object, with parsing options.
+ * 
+ * This function behaves like `goblin3d_parse_obj_buffer`, but accepts a set of
+ * `GOBLIN3D_PARSE_*` flags. `GOBLIN3D_PARSE_EXACT` is especially cheap here, since the
+ * counting pass only rereads memory. `GOBLIN3D_PARSE_MMAP` has no effect.
+ * 
+ * @param data Pointer to the OBJ text.
+ * @param length The number of bytes in `data`.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags.
+ * @return `true` if the data was successfully parsed and the object constructed,
+ *         `false` if a memory allocation error occurred.
+ */
+bool goblin3d_parse_obj_buffer_ex(const char* data, size_t length, goblin3d_obj_t* obj, uint8_t flags);
+
+/**
+ * @brief Parses a binary STL file to construct a Goblin3D object.
+ * 
+ * The 50-byte triangle records are read in blocks of `GOBLIN3D_PARSE_BLOCK_SIZE` bytes
+ * (from the SD card on Arduino), or straight from a memory mapping on POSIX hosts.
+ * STL stores every triangle with its own copy of its corners, so corners at the same
+ * position are welded into one point through a hash table keyed by position, and
+ * shared edges are merged. Degenerate triangles are skipped.
+ * 
+ * CAD exports tessellate flat and gently curved surfaces into many small triangles.
+ * When `feature_angle` is positive, an edge between two triangles whose normals differ
+ * by less than `feature_angle` degrees is dropped, so only silhouettes, creases and
+ * open borders are drawn. Points left without edges are dropped as well, unless faces
+ * are retained, in which case the dropped edges are simply not drawn.
+ * 
+ * @param filename The path to the STL file to parse.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @param feature_angle The smallest angle, in degrees, between the normals of two
+ *        adjacent triangles for their shared edge to be kept, or 0 to keep every edge.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags; only `GOBLIN3D_PARSE_KEEP_FACES` applies.
+ * @return `true` if the STL file was successfully parsed and the object constructed,
+ *         `false` if an error occurred (e.g., file not found, truncated file, memory
+ *         allocation failure).
+ */
+bool goblin3d_parse_stl_file(const char* filename, goblin3d_obj_t* obj, float feature_angle, uint8_t flags);
+
+/**
+ * @brief Parses binary STL data held in memory to construct a Goblin3D object.
+ * 
+ * This function behaves like `goblin3d_parse_stl_file`, reading the records directly
+ * from `data`.
+ * 
+ * @param data Pointer to the binary STL data.
+ * @param length The number of bytes in `data`.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @param feature_angle The smallest angle, in degrees, between the normals of two
+ *        adjacent triangles for their shared edge to be kept, or 0 to keep every edge.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags; only `GOBLIN3D_PARSE_KEEP_FACES` applies.
+ * @return `true` if the data was successfully parsed and the object constructed,
+ *         `false` if the data is truncated or a memory allocation error occurred.
+ */
+bool goblin3d_parse_stl_buffer(const void* data, size_t length, goblin3d_obj_t* obj,
+    float feature_angle, uint8_t flags);
+
+/**
+ * @brief Parses a binary little-endian PLY file to construct a Goblin3D object.
+ * 
+ * The header is read first to lay out every element. The `x`, `y` and `z` properties
+ * of the `vertex` element may appear in any order, of any scalar type, among any
+ * other properties; they are copied out of whole blocks of fixed-size records with
+ * strided loads, or with a single copy when the records hold exactly three floats.
+ * The `vertex_indices` lists of an optional `face` element are turned into edges,
+ * split into triangle fans when faces are retained. Files without faces, such as
+ * scanned point clouds, load as points without edges. Other elements are skipped.
+ * 
+ * Blocks are read `GOBLIN3D_PARSE_BLOCK_SIZE` bytes at a time (from the SD card on
+ * Arduino), or straight from a memory mapping on POSIX hosts.
+ * 
+ * @param filename The path to the PLY file to parse.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags; only `GOBLIN3D_PARSE_KEEP_FACES` and
+ *        `GOBLIN3D_PARSE_WELD` apply.
+ * @return `true` if the PLY file was successfully parsed and the object constructed,
+ *         `false` if an error occurred (e.g., file not found, unsupported format,
+ *         truncated file, memory allocation failure).
+ */
+bool goblin3d_parse_ply_file(const char* filename, goblin3d_obj_t* obj, uint8_t flags);
+
+/**
+ * @brief Parses binary little-endian PLY data held in memory to construct a Goblin3D object.
+ * 
+ * This function behaves like `goblin3d_parse_ply_file`, reading vertex records
+ * directly from `data`.
+ * 
+ * @param data Pointer to the PLY data.
+ * @param length The number of bytes in `data`.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags; only `GOBLIN3D_PARSE_KEEP_FACES` and
+ *        `GOBLIN3D_PARSE_WELD` apply.
+ * @return `true` if the data was successfully parsed and the object constructed,
+ *         `false` if the data is not supported, truncated, or a memory allocation
+ *         error occurred.
+ */
+bool goblin3d_parse_ply_buffer(const void* data, size_t length, goblin3d_obj_t* obj, uint8_t flags);
+
+/**
+ * @brief Loads a Goblin3D binary mesh file.
+ * 
+ * On POSIX hosts the file is memory-mapped, and when its points are stored as floats
+ * the object's points, edges, faces and strips point straight into the mapping, which
+ * stays alive until `goblin3d_free`. Otherwise, and on Arduino where the file is read
+ * from the SD card, every section is read in one sequential pass directly into the
+ * object's arrays, with no text parsing.
+ * 
+ * Functions that add to or rearrange the geometry first copy mapped arrays to the heap.
+ * 
+ * Since files may be corrupted, every edge, face and strip index is checked once
+ * against the point and edge counts, and strip offsets must increase up to the
+ * stored number of strip indices; a mesh failing these checks is rejected.
+ * 
+ * @param filename The path to the binary mesh file.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @return `true` if the mesh was loaded, `false` if the file could not be read, is not
+ *         a supported binary mesh, or a memory allocation error occurred.
+ */
+bool goblin3d_load_binary(const char* filename, goblin3d_obj_t* obj);
+
+/**
+ * @brief Loads a Goblin3D binary mesh held in memory.
+ * 
+ * Arrays stored as floats or indices are used in place without copying when `data`
+ * is 4-byte aligned, so the data must stay valid and unchanged for the lifetime of
+ * the object. This suits meshes embedded in flash. Indices are validated as in
+ * `goblin3d_load_binary`.
+ * 
+ * @param data Pointer to the binary mesh.
+ * @param length The number of bytes in `data`.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @return `true` if the mesh was loaded, `false` if the data is not a supported binary
+ *         mesh or a memory allocation error occurred.
+ */
+bool goblin3d_load_binary_buffer(const void* data, size_t length, goblin3d_obj_t* obj);
+
+/**
+ * @brief Loads a Goblin3D baked animation file.
+ * 
+ * The frames are read into memory in one sequential pass, from the SD card on Arduino.
+ * 
+ * @param filename The path to the baked animation file.
+ * @param animation Pointer to the `goblin3d_animation_t` structure to fill.
+ * @return `true` if the animation was loaded, `false` if the file could not be read, is
+ *         not a supported baked animation, or a memory allocation error occurred.
+ */
+bool goblin3d_load_animation(const char* filename, goblin3d_animation_t* animation);
+
+/**
+ * @brief Loads a Goblin3D baked animation held in memory.
+ * 
+ * The frames are used in place without copying when `data` is 2-byte aligned, so the
+ * data must stay valid and unchanged for the lifetime of the animation. This suits
+ * animations embedded in flash.
+ * 
+ * @param data Pointer to the baked animation.
+ * @param length The number of bytes in `data`.
+ * @param animation Pointer to the `goblin3d_animation_t` structure to fill.
+ * @return `true` if the animation was loaded, `false` if the data is not a supported
+ *         baked animation or a memory allocation error occurred.
+ */
+bool goblin3d_load_animation_buffer(const void* data, size_t length, goblin3d_animation_t* animation);
+
+#ifndef ARDUINO
+
+/**
+ * @brief Saves a 3D object as a Goblin3D binary mesh file.
+ * 
+ * Faces and strips are written when the object has them.
+ * 
+ * @param obj A pointer to the Goblin3D object to save.
+ * @param filename The path of the file to write.
+ * @param flags `GOBLIN3D_BINARY_QUANTIZED` to store points as 16-bit values, or 0.
+ * @return `true` if the file was written, `false` if an I/O error occurred.
+ */
+bool goblin3d_save_binary(goblin3d_obj_t* obj, const char* filename, uint16_t flags);
+
+/**
+ * @brief Saves a baked animation as a Goblin3D baked animation file.
+ * 
+ * @param animation Pointer to the baked animation to save.
+ * @param filename The path of the file to write.
+ * @return `true` if the file was written, `false` if an I/O error occurred.
+ */
+bool goblin3d_save_animation(const goblin3d_animation_t* animation, const char* filename);
+
+#endif
+
+#ifdef GOBLIN3D_POSIX
+
+/**
+ * @brief Parses OBJ data held in memory using several threads.
+ * 
+ * The data is split into one chunk per thread at line boundaries. Each thread
+ * tokenizes its chunk into thread-local vertex and polygon arrays, then resolves its
+ * indices once the vertex counts of the preceding chunks are known, producing a
+ * sorted set of edges. These sets are merged into the object in parallel, each thread
+ * handling one range of edges, so no edge is stored twice.
+ * 
+ * The threads are started once per call and wait on a condition variable between
+ * phases. The resulting object holds the same points and faces as with
+ * `goblin3d_parse_obj_buffer_ex`, but its edges are sorted by point index instead of
+ * being stored in order of first appearance.
+ * 
+ * This path is opt-in: no other parse function uses it. Its scaling with the number
+ * of threads has not been measured, and on a single core it is slower than the
+ * serial parser, so prefer `goblin3d_parse_obj_buffer_ex` unless profiling on the
+ * target shows a gain.
+ * 
+ * @param data Pointer to the OBJ text.
+ * @param length The number of bytes in `data`.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags; only `GOBLIN3D_PARSE_KEEP_FACES` and
+ *        `GOBLIN3D_PARSE_WELD` apply.
+ * @param thread_count The number of threads to use, including the calling thread.
+ * @return `true` if the data was successfully parsed and the object constructed,
+ *         `false` if a memory allocation or thread creation error occurred.
+ */
+bool goblin3d_parse_obj_buffer_parallel(const char* data, size_t length, goblin3d_obj_t* obj,
+    uint8_t flags, uint8_t thread_count);
+
+/**
+ * @brief Parses an OBJ file using several threads.
+ * 
+ * The file is memory-mapped and handed to `goblin3d_parse_obj_buffer_parallel`. If it
+ * cannot be mapped, it is parsed on the calling thread by `goblin3d_parse_obj_file_ex`.
+ * 
+ * @param filename The path to the OBJ file to parse.
+ * @param obj A pointer to the Goblin3D object to populate.
+ * @param flags Bitwise OR of `GOBLIN3D_PARSE_*` flags.
+ * @param thread_count The number of threads to use, including the calling thread.
+ * @return `true` if the OBJ file was successfully parsed and the object constructed,
+ *         `false` if an error occurred (e.g., file not found, memory allocation failure).
+ */
+bool goblin3d_parse_obj_file_parallel(const char* filename, goblin3d_obj_t* obj,
+    uint8_t flags, uint8_t thread_count);
+
+/**
+ * @brief Opens a Goblin3D binary mesh for streaming rendering.
+ * 
+ * The file is memory-mapped and only its header is read, so meshes much larger than
+ * the available memory can be opened. The window holds the projected coordinates of
+ * up to `window_size` points (rounded up to a power of two), taking 12 bytes per
+ * point. Meshes saved after `goblin3d_optimize` use their edges in nearly increasing
+ * point order, which lets a window of a few thousand points serve almost every edge.
+ * 
+ * The transformation fields of the stream are zeroed and must be set before rendering.
+ * 
+ * @param stream Pointer to the `goblin3d_stream_t` structure to initialize.
+ * @param filename The path to the binary mesh file.
+ * @param window_size The number of projected points to keep, at least 64.
+ * @return `true` if the mesh was opened, `false` if the file could not be mapped, is not
+ *         a supported binary mesh, or a memory allocation error occurred.
+ */
+bool goblin3d_stream_open(goblin3d_stream_t* stream, const char* filename, uint32_t window_size);
+
+/**
+ * @brief Unmaps a streamed binary mesh and frees its window.
+ * 
+ * @param stream Pointer to the `goblin3d_stream_t` structure to close.
+ */
+void goblin3d_stream_close(goblin3d_stream_t* stream);
+
+/**
+ * @brief Renders a streamed binary mesh as a wireframe.
+ * 
+ * Edges are read from the mapping `GOBLIN3D_STREAM_CHUNK` at a time. Each endpoint is
+ * looked up in the window and transformed only when its slot holds another point, so
+ * a point shared by nearby edges is projected once. After a chunk has been drawn, its
+ * pages are handed back to the kernel, and so are the pages of points no later edge
+ * can reach while the edges seen so far are sorted as by `goblin3d_optimize`. Peak
+ * memory thus stays bounded by the window and a few chunks, whatever the size of the
+ * mesh. Edges referencing points outside the mesh are skipped.
+ * 
+ * @param stream Pointer to an opened `goblin3d_stream_t`.
+ * @param draw A callback function used to draw lines between the points on the 2D plane.
+ */
+void goblin3d_render_stream(goblin3d_stream_t* stream, goblin3d_obj_draw_fn draw);
+
+#endif
+
 #endif /* GOBLIN3D_H */
\ No newline at end of file
@@ -0,0 +1,2 @@
+mkdir -p ../../dist
+g++ -O2 -o ../../dist/goblin3d_convert -I../../src ../../src/goblin3d.cpp goblin3d_convert.c -lm -lpthread
@@ -0,0 +1,337 @@
+/*
+ * This file is part of the Goblin3D.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <ctype.h>
+#include <goblin3d.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define VALUES_PER_LINE     4       // Points or edges written per line of a header
+
+float weld_epsilon = -1.0f;         // Welding distance, negative to skip welding
+uint32_t target_edges = 0;          // Simplification target, 0 keeps every edge
+bool quantize = false;              // Store binary points as 16-bit values
+bool strips = false;                // Build edge strips into the binary mesh
+bool keep_faces = false;            // Keep faces for hidden-line and filled rendering
+bool header_output = false;         // Write a C header instead of a binary mesh
+const char* name = NULL;            // Identifier prefix used in the C header
+
+static void usage(const char* program) {
+    fprintf(stderr,
+        "Usage: %s [options] input.obj output\n"
+        "\n"
+        "Options:\n"
+        "  -w EPS     Merge points closer than EPS (0 merges identical positions)\n"
+        "  -s EDGES   Simplify the mesh down to at most EDGES edges\n"
+        "  -q         Quantize points to 16 bits (binary output only)\n"
+        "  -t         Build edge strips (binary output only)\n"
+        "  -k         Keep faces (binary output only)\n"
+        "  -f FORMAT  Output format, 'binary' or 'header' (default: from extension)\n"
+        "  -n NAME    Identifier prefix for header output (default: from file name)\n",
+        program);
+}
+
+/*
+ * Derives a C identifier from the base name of
+ * the output file, replacing anything that is not
+ * alphanumeric by underscores.
+ */
+static char* identifier_from_path(const char* path) {
+    const char* base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+
+    size_t length = strcspn(base, ".");
+    char* identifier = (char*) malloc(length + 2);
+    if(!identifier)
+        return NULL;
+
+    size_t offset = 0;
+    if(length == 0 || isdigit((unsigned char) base[0]))
+        identifier[offset++] = '_';
+
+    for(size_t i = 0; i < length; i++)
+        identifier[offset++] = isalnum((unsigned char) base[i]) ? base[i] : '_';
+    identifier[offset] = '\0';
+
+    return identifier;
+}
+
+/*
+ * Drops the points no edge or face refers to.
+ * The remaining points keep the order given by
+ * goblin3d_optimize() and are renumbered through
+ * a remap table, since unused points may sit
+ * between points used only by faces.
+ */
+static bool drop_unused_points(goblin3d_obj_t* obj) {
+    uint32_t* remap = (uint32_t*) malloc(sizeof(uint32_t) * (obj->point_count + 1));
+    if(!remap)
+        return false;
+
+    for(uint32_t i = 0; i < obj->point_count; i++)
+        remap[i] = UINT32_MAX;
+
+    for(uint32_t i = 0; i < obj->edge_count; i++)
+        for(uint8_t j = 0; j < 2; j++)
+            remap[obj->edges[i][j]] = 0;
+
+    for(uint32_t i = 0; i < obj->face_count; i++)
+        for(uint8_t j = 0; j < 3; j++)
+            remap[obj->faces[i][j]] = 0;
+
+    uint32_t kept = 0;
+    for(uint32_t i = 0; i < obj->point_count; i++) {
+        if(remap[i] == UINT32_MAX)
+            continue;
+
+        memmove(obj->orig_points[kept], obj->orig_points[i], sizeof(float[3]));
+        remap[i] = kept++;
+    }
+
+    for(uint32_t i = 0; i < obj->edge_count; i++)
+        for(uint8_t j = 0; j < 2; j++)
+            obj->edges[i][j] = remap[obj->edges[i][j]];
+
+    for(uint32_t i = 0; i < obj->face_count; i++)
+        for(uint8_t j = 0; j < 3; j++)
+            obj->faces[i][j] = remap[obj->faces[i][j]];
+
+    obj->point_count = kept;
+    obj->bounds_valid = false;
+    free(remap);
+
+    return true;
+}
+
+/*
+ * Releases the faces retained for simplification
+ * when the output does not need them.
+ */
+static void drop_faces(goblin3d_obj_t* obj) {
+    free(obj->faces);
+    free(obj->face_edges);
+    free(obj->edge_flags);
+
+    obj->faces = NULL;
+    obj->face_edges = NULL;
+    obj->edge_flags = NULL;
+    obj->face_count = 0;
+}
+
+/*
+ * Writes the points and edges as const arrays
+ * ready for goblin3d_init_from_arrays(), so the
+ * mesh can stay in flash on the device.
+ */
+static bool write_header(goblin3d_obj_t* obj, const char* input, const char* output) {
+    FILE* file = fopen(output, "w");
+    if(!file)
+        return false;
+
+    char* guard = strdup(name);
+    if(!guard) {
+        fclose(file);
+        return false;
+    }
+
+    for(char* c = guard; *c; c++)
+        *c = toupper((unsigned char) *c);
+
+    fprintf(file,
+        "/*\n"
+        " * Generated by goblin3d_convert from %s.\n"
+        " *\n"
+        " *     goblin3d_obj_t obj;\n"
+        " *     goblin3d_init_from_arrays(&obj, %s_points, %s_POINT_COUNT,\n"
+        " *         %s_edges, %s_EDGE_COUNT);\n"
+        " */\n"
+        "\n"
+        "#ifndef %s_MESH_H\n"
+        "#define %s_MESH_H\n"
+        "\n"
+        "#include <stdint.h>\n"
+        "\n"
+        "#define %s_POINT_COUNT %u\n"
+        "#define %s_EDGE_COUNT %u\n"
+        "\n"
+        "static const float %s_points[%u][3] = {",
+        input, name, guard, name, guard, guard, guard,
+        guard, obj->point_count, guard, obj->edge_count,
+        name, obj->point_count > 0 ? obj->point_count : 1);
+
+    for(uint32_t i = 0; i < obj->point_count; i++)
+        fprintf(file, "%s{%.9g, %.9g, %.9g}%s",
+            i % VALUES_PER_LINE == 0 ? "\n    " : " ",
+            obj->orig_points[i][0], obj->orig_points[i][1], obj->orig_points[i][2],
+            i + 1 < obj->point_count ? "," : "");
+
+    fprintf(file, "%s};\n\nstatic const uint32_t %s_edges[%u][2] = {",
+        obj->point_count > 0 ? "\n" : "{0, 0, 0}", name,
+        obj->edge_count > 0 ? obj->edge_count : 1);
+
+    for(uint32_t i = 0; i < obj->edge_count; i++)
+        fprintf(file, "%s{%u, %u}%s",
+            i % (VALUES_PER_LINE * 2) == 0 ? "\n    " : " ",
+            obj->edges[i][0], obj->edges[i][1],
+            i + 1 < obj->edge_count ? "," : "");
+
+    fprintf(file, "%s};\n\n#endif\n", obj->edge_count > 0 ? "\n" : "{0, 0}");
+    free(guard);
+
+    return fclose(file) == 0;
+}
+
+int main(int argc, char** argv) {
+    const char* format = NULL;
+    char* end;
+    int option;
+
+    while((option = getopt(argc, argv, "w:s:qtkf:n:")) != -1)
+        switch(option) {
+            case 'w':
+                weld_epsilon = strtof(optarg, &end);
+                if(end == optarg || *end != '\0' || !(weld_epsilon >= 0.0f)) {
+                    fprintf(stderr, "Invalid welding distance: %s\n", optarg);
+                    return 1;
+                }
+                break;
+
+            case 's': {
+                unsigned long value = strtoul(optarg, &end, 10);
+                if(!isdigit((unsigned char) optarg[0]) || *end != '\0' || value > UINT32_MAX) {
+                    fprintf(stderr, "Invalid edge count: %s\n", optarg);
+                    return 1;
+                }
+
+                target_edges = (uint32_t) value;
+                break;
+            }
+
+            case 'q': quantize = true; break;
+            case 't': strips = true; break;
+            case 'k': keep_faces = true; break;
+            case 'f': format = optarg; break;
+            case 'n': name = optarg; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+
+    if(argc - optind != 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const char* input = argv[optind];
+    const char* output = argv[optind + 1];
+
+    if(format)
+        header_output = strcmp(format, "header") == 0;
+    else {
+        const char* extension = strrchr(output, '.');
+        header_output = extension && strcmp(extension, ".h") == 0;
+    }
+
+    if(format && !header_output && strcmp(format, "binary") != 0) {
+        fprintf(stderr, "Unknown output format: %s\n", format);
+        return 1;
+    }
+
+    if(header_output && (quantize || strips || keep_faces))
+        fprintf(stderr, "Note: -q, -t and -k only apply to binary output.\n");
+
+    // Faces are always parsed, since simplification
+    // measures error against the face planes.
+    goblin3d_obj_t obj;
+    if(!goblin3d_parse_obj_file_ex(input, &obj,
+        GOBLIN3D_PARSE_KEEP_FACES | GOBLIN3D_PARSE_MMAP | GOBLIN3D_PARSE_EXACT)) {
+        fprintf(stderr, "Failed to load %s\n", input);
+        return 1;
+    }
+
+    printf("Loaded %s: %u points, %u edges, %u faces\n",
+        input, obj.point_count, obj.edge_count, obj.face_count);
+
+    if(weld_epsilon >= 0.0f) {
+        if(!goblin3d_weld(&obj, weld_epsilon)) {
+            fprintf(stderr, "Out of memory while welding\n");
+            goblin3d_free(&obj);
+            return 1;
+        }
+
+        printf("Welded to %u points, %u edges\n", obj.point_count, obj.edge_count);
+    }
+
+    if(target_edges > 0 && target_edges < obj.edge_count) {
+        if(!goblin3d_simplify(&obj, target_edges)) {
+            fprintf(stderr, "Out of memory while simplifying\n");
+            goblin3d_free(&obj);
+            return 1;
+        }
+
+        printf("Simplified to %u edges\n", obj.edge_count);
+    }
+
+    if(header_output || !keep_faces)
+        drop_faces(&obj);
+
+    if(!goblin3d_optimize(&obj)) {
+        fprintf(stderr, "Out of memory while reordering\n");
+        goblin3d_free(&obj);
+        return 1;
+    }
+
+    if(!drop_unused_points(&obj)) {
+        fprintf(stderr, "Out of memory while dropping unused points\n");
+        goblin3d_free(&obj);
+        return 1;
+    }
+
+    if(!header_output && strips && !goblin3d_build_strips(&obj)) {
+        fprintf(stderr, "Out of memory while building strips\n");
+        goblin3d_free(&obj);
+        return 1;
+    }
+
+    bool written;
+    char* generated_name = NULL;
+
+    if(header_output) {
+        if(!name)
+            name = generated_name = identifier_from_path(output);
+        written = name && write_header(&obj, input, output);
+    }
+    else written = goblin3d_save_binary(&obj, output, quantize ? GOBLIN3D_BINARY_QUANTIZED : 0);
+
+    if(written)
+        printf("Wrote %s: %u points, %u edges, %u faces, %u strips\n",
+            output, obj.point_count, obj.edge_count, obj.face_count, obj.strip_count);
+    else fprintf(stderr, "Failed to write %s\n", output);
+
+    free(generated_name);
+    goblin3d_free(&obj);
+
+    return written ? 0 : 1;
+}